@@ -0,0 +1,244 @@
+// Host-side latency harness for the Exchange library calls
+//
+// Drives check_address, get_printable_amount and create_transaction with
+// the inputs Exchange sends for a Hedera swap, and reports the time and the
+// stack depth of each call. The signing request goes through
+// handle_sign_transaction as on the device, from the APDU buffer to the
+// reply to Exchange. The derivation and the signature are stubbed:
+// the figures cover the app logic only, and are meant to be compared from
+// one build to the next rather than with the device.
+
+#include <pb_decode.h>
+#include <pb_encode.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "bench_mock.h"
+#include "handle_check_address.h"
+#include "handle_get_printable_amount.h"
+#include "handle_swap_sign_transaction.h"
+#include "handlers.h"
+#include "hedera.h"
+#include "sign_transaction.h"
+#include "utils.h"
+
+#define DEFAULT_ITERATIONS 100000
+
+// Stack below the measuring frame painted before each call
+#define STACK_PROBE_SIZE (32 * 1024)
+#define STACK_PATTERN 0xA5
+
+// m/44'/3030'/0'/0'/0', as sent by Ledger Live
+static const uint8_t derivation_path[] = {
+    0x05,                   //
+    0x80, 0x00, 0x00, 0x2C, //
+    0x80, 0x00, 0x0B, 0xD6, //
+    0x80, 0x00, 0x00, 0x00, //
+    0x80, 0x00, 0x00, 0x00, //
+    0x80, 0x00, 0x00, 0x00, //
+};
+
+// 1 HBAR and a 0.001 HBAR fee, big endian as sent by Exchange
+static const uint8_t swap_amount[] = {0x05, 0xF5, 0xE1, 0x00};
+static const uint8_t swap_fee[] = {0x01, 0x86, 0xA0};
+#define SWAP_AMOUNT 100000000
+#define SWAP_FEE 100000
+#define SWAP_DESTINATION "100.101.110"
+
+// P1_NON_CONFIRM, as sent by the hosts: signature only
+#define SWAP_P1 0x01
+
+static char address_to_check[2 * PUBKEY_LENGTH + 1];
+
+static uint8_t body[MAX_TX_SIZE];
+static size_t body_length;
+
+typedef struct bench_result_s {
+    const char *name;
+    double ns_per_call;
+    size_t stack_bytes;
+} bench_result_t;
+
+static __attribute__((noinline)) void stack_paint(void) {
+    volatile uint8_t area[STACK_PROBE_SIZE];
+    for (size_t i = 0; i < sizeof(area); i++) {
+        area[i] = STACK_PATTERN;
+    }
+}
+
+// The deepest byte written since stack_paint, seen from the same frame: the
+// area is left uninitialized on purpose
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"
+static __attribute__((noinline)) size_t stack_used(void) {
+    volatile uint8_t area[STACK_PROBE_SIZE];
+    size_t untouched = 0;
+    while (untouched < sizeof(area) && area[untouched] == STACK_PATTERN) {
+        untouched++;
+    }
+    return sizeof(area) - untouched;
+}
+#pragma GCC diagnostic pop
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+// Transfer of SWAP_AMOUNT from 0.0.1234 to SWAP_DESTINATION
+static void encode_swap_body(void) {
+    Hedera_TransactionBody transaction = Hedera_TransactionBody_init_zero;
+
+    transaction.has_transactionID = true;
+    transaction.transactionID.has_transactionValidStart = true;
+    transaction.transactionID.transactionValidStart.seconds = 1700000000;
+    transaction.transactionID.has_accountID = true;
+    transaction.transactionID.accountID.which_account =
+        Hedera_AccountID_accountNum_tag;
+    transaction.transactionID.accountID.account.accountNum = 1234;
+    transaction.has_nodeAccountID = true;
+    transaction.nodeAccountID.which_account = Hedera_AccountID_accountNum_tag;
+    transaction.nodeAccountID.account.accountNum = 3;
+    transaction.transactionFee = SWAP_FEE;
+    transaction.has_transactionValidDuration = true;
+    transaction.transactionValidDuration.seconds = 120;
+    strcpy(transaction.memo, "swap");
+
+    transaction.which_data = Hedera_TransactionBody_cryptoTransfer_tag;
+    Hedera_TransferList *transfers =
+        &transaction.data.cryptoTransfer.transfers;
+    transaction.data.cryptoTransfer.has_transfers = true;
+    transfers->accountAmounts_count = 2;
+    transfers->accountAmounts[0].has_accountID = true;
+    transfers->accountAmounts[0].accountID.which_account =
+        Hedera_AccountID_accountNum_tag;
+    transfers->accountAmounts[0].accountID.account.accountNum = 1234;
+    transfers->accountAmounts[0].amount = -SWAP_AMOUNT;
+    transfers->accountAmounts[1].has_accountID = true;
+    transfers->accountAmounts[1].accountID.shardNum = 100;
+    transfers->accountAmounts[1].accountID.realmNum = 101;
+    transfers->accountAmounts[1].accountID.which_account =
+        Hedera_AccountID_accountNum_tag;
+    transfers->accountAmounts[1].accountID.account.accountNum = 110;
+    transfers->accountAmounts[1].amount = SWAP_AMOUNT;
+
+    pb_ostream_t stream = pb_ostream_from_buffer(body, sizeof(body));
+    if (!pb_encode(&stream, Hedera_TransactionBody_fields, &transaction)) {
+        fprintf(stderr, "Cannot encode the swap body\n");
+        exit(EXIT_FAILURE);
+    }
+    body_length = stream.bytes_written;
+}
+
+static bool run_check_address(void) {
+    check_address_parameters_t params = {
+        .address_parameters = derivation_path,
+        .address_parameters_length = sizeof(derivation_path),
+        .address_to_check = address_to_check,
+        .extra_id_to_check = "",
+    };
+    return handle_check_address(&params) == 1;
+}
+
+static bool run_get_printable_amount(void) {
+    get_printable_amount_parameters_t params = {
+        .amount = swap_amount,
+        .amount_length = sizeof(swap_amount),
+    };
+    return swap_handle_get_printable_amount(&params) == 1 &&
+           strcmp(params.printable_amount, "1 HBAR") == 0;
+}
+
+// Library call, then the signing request of the swap through the app's own
+// handler, up to the return to Exchange
+static bool run_create_transaction(void) {
+    create_transaction_parameters_t params = {
+        .amount = swap_amount,
+        .amount_length = sizeof(swap_amount),
+        .fee_amount = swap_fee,
+        .fee_amount_length = sizeof(swap_fee),
+        .destination_address = SWAP_DESTINATION,
+        .destination_address_extra_id = "",
+    };
+    volatile unsigned int flags = 0;
+    volatile unsigned int tx = 0;
+
+    bench_reply_length = 0;
+    if (setjmp(bench_lib_end) == 0) {
+        if (!copy_transaction_parameters(&params)) {
+            return false;
+        }
+
+        // As the app starts from the library call
+        G_called_from_swap = true;
+        G_swap_response_ready = false;
+
+        // index (4, LE) | body, with the P1 of the hosts
+        memset(G_io_apdu_buffer, 0, OFFSET_CDATA + INDEX_SIZE);
+        memcpy(G_io_apdu_buffer + OFFSET_CDATA + INDEX_SIZE, body,
+               body_length);
+        handle_sign_transaction(SWAP_P1, 0, G_io_apdu_buffer + OFFSET_CDATA,
+                                INDEX_SIZE + body_length, &flags, &tx);
+    }
+
+    // Signature and status word
+    return params.result == 1 &&
+           bench_reply_length == ED25519_SIGNATURE_SIZE + 2 &&
+           G_io_apdu_buffer[0] == BENCH_SIGNATURE_BYTE &&
+           U2BE(G_io_apdu_buffer, ED25519_SIGNATURE_SIZE) == EXCEPTION_OK;
+}
+
+static bench_result_t bench(const char *name, bool (*run)(void),
+                            unsigned long iterations) {
+    bench_result_t result = {.name = name};
+
+    // The first call resolves the libc symbols, on a deeper stack
+    if (!run()) {
+        fprintf(stderr, "%s failed\n", name);
+        exit(EXIT_FAILURE);
+    }
+
+    stack_paint();
+    run();
+    result.stack_bytes = stack_used();
+
+    uint64_t start = now_ns();
+    for (unsigned long i = 0; i < iterations; i++) {
+        run();
+    }
+    result.ns_per_call = (double)(now_ns() - start) / iterations;
+
+    return result;
+}
+
+int main(int argc, char *argv[]) {
+    unsigned long iterations = DEFAULT_ITERATIONS;
+    if (argc > 1) {
+        iterations = strtoul(argv[1], NULL, 10);
+        if (iterations == 0) {
+            fprintf(stderr, "usage: %s [iterations]\n", argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    bin2hex((uint8_t *)address_to_check, (uint8_t *)bench_public_key,
+            PUBKEY_LENGTH);
+    encode_swap_body();
+
+    const bench_result_t results[] = {
+        bench("check_address", run_check_address, iterations),
+        bench("get_printable_amount", run_get_printable_amount, iterations),
+        bench("create_transaction", run_create_transaction, iterations),
+    };
+
+    printf("%-24s %12s %14s\n", "entry point", "ns/call", "stack (bytes)");
+    for (size_t i = 0; i < ARRAY_COUNT(results); i++) {
+        printf("%-24s %12.1f %14zu\n", results[i].name,
+               results[i].ns_per_call, results[i].stack_bytes);
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,165 @@
+#include "bench_mock.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "hedera.h"
+#include "sign_transaction.h"
+#include "tokens/cal/token_lookup.h"
+
+uint8_t G_io_apdu_buffer[IO_APDU_BUFFER_SIZE];
+
+volatile bool G_called_from_swap;
+volatile bool G_swap_response_ready;
+
+jmp_buf bench_lib_end;
+
+unsigned short bench_reply_length;
+
+// Arbitrary key, the derivation itself is not measured
+const uint8_t bench_public_key[PUBKEY_LENGTH] = {
+    0x78, 0xbe, 0x74, 0x7e, 0x6a, 0x0c, 0x29, 0x0a, 0x2b, 0xd7, 0x01,
+    0xb2, 0x4b, 0x46, 0x9f, 0x1c, 0x4d, 0x5a, 0x0b, 0x35, 0x1e, 0x13,
+    0x7c, 0x4b, 0xb0, 0x98, 0x91, 0x62, 0xc7, 0x0d, 0x0e, 0x09,
+};
+
+static void __attribute__((noreturn)) unexpected(const char *what) {
+    fprintf(stderr, "Unexpected %s\n", what);
+    exit(EXIT_FAILURE);
+}
+
+bool hedera_get_public_key(uint32_t index,
+                           uint8_t pubkey[static PUBKEY_LENGTH]) {
+    (void)index;
+    memcpy(pubkey, bench_public_key, PUBKEY_LENGTH);
+    return true;
+}
+
+// Fixed signature, the signature itself is not measured
+bool hedera_sign(uint32_t index, const uint8_t *tx, size_t tx_len,
+                 uint8_t *result, size_t *sig_len_out) {
+    (void)index;
+    (void)tx;
+    (void)tx_len;
+    memset(result, BENCH_SIGNATURE_BYTE, ED25519_SIGNATURE_SIZE);
+    if (sig_len_out) *sig_len_out = ED25519_SIGNATURE_SIZE;
+    return true;
+}
+
+// Its SHA-256 of the body is left to the SDK, like the signature
+void hedera_signature_cache_add(uint32_t index, const uint8_t *tx,
+                                size_t tx_len,
+                                const uint8_t signature[static ED25519_SIGNATURE_SIZE]) {
+    (void)index;
+    (void)tx;
+    (void)tx_len;
+    (void)signature;
+}
+
+// Exchange sends a single plain request: the other signatures, the session
+// caches and the reviews are never reached
+
+bool hedera_sign_with_pubkey(uint32_t index, const uint8_t *tx, size_t tx_len,
+                             uint8_t *result, size_t *sig_len_out,
+                             uint8_t pubkey[static PUBKEY_LENGTH]) {
+    unexpected("signature with the public key");
+}
+
+bool hedera_sign_keep_key(uint32_t index, const uint8_t *tx, size_t tx_len,
+                          uint8_t *result, size_t *sig_len_out) {
+    unexpected("signature with a kept key");
+}
+
+bool hedera_sign_ecdsa(uint32_t index,
+                       const uint8_t digest[static SECP256K1_SCALAR_SIZE],
+                       uint8_t *result, size_t *sig_len_out) {
+    unexpected("secp256k1 signature");
+}
+
+bool hedera_stream_sign_init(uint32_t index, hedera_stream_sign_t *ctx) {
+    unexpected("streamed signature");
+}
+
+bool hedera_stream_sign_update(hedera_stream_sign_t *ctx, const uint8_t *data,
+                               size_t data_len) {
+    unexpected("streamed signature");
+}
+
+bool hedera_stream_sign_nonce(hedera_stream_sign_t *ctx) {
+    unexpected("streamed signature");
+}
+
+bool hedera_stream_sign_final(uint32_t index, hedera_stream_sign_t *ctx,
+                              uint8_t *result, size_t *sig_len_out) {
+    unexpected("streamed signature");
+}
+
+void hedera_cache_reset(void) {
+    unexpected("device lock");
+}
+
+bool hedera_signature_cache_find(uint32_t index, const uint8_t *tx,
+                                 size_t tx_len,
+                                 uint8_t signature[static ED25519_SIGNATURE_SIZE]) {
+    unexpected("signature cache");
+}
+
+cx_err_t cx_sha256_init_no_throw(cx_sha256_t *hash) {
+    unexpected("hash");
+}
+
+cx_err_t cx_keccak_init_no_throw(cx_sha3_t *hash, size_t size) {
+    unexpected("hash");
+}
+
+cx_err_t cx_hash_no_throw(cx_hash_t *hash, uint32_t mode, const uint8_t *in,
+                          size_t len, uint8_t *out, size_t out_len) {
+    unexpected("hash");
+}
+
+void ui_sign_transaction(void) {
+    unexpected("review");
+}
+
+void io_exchange_with_code(uint16_t code, uint16_t tx) {
+    unexpected("reply outside of the swap path");
+}
+
+bool token_info_get_by_address(const token_addr_t address,
+                               char ticker[MAX_TICKER_LENG],
+                               char name[MAX_TOKEN_LEN], uint32_t *decimals) {
+    unexpected("token lookup");
+}
+
+bool token_info_get_by_evm_address(const evm_address_t *evm_address,
+                                   char ticker[MAX_TICKER_LENG],
+                                   char name[MAX_TOKEN_LEN],
+                                   uint32_t *decimals) {
+    unexpected("token lookup");
+}
+
+void _putchar(char character) {
+    (void)character;
+}
+
+// The reply to Exchange, sent before returning to it
+unsigned short io_exchange(unsigned char channel, unsigned short tx_len) {
+    (void)channel;
+    bench_reply_length = tx_len;
+    return 0;
+}
+
+void os_lib_end(void) {
+    longjmp(bench_lib_end, 1);
+}
+
+void os_sched_exit(int exit_code) {
+    (void)exit_code;
+    unexpected("second swap signature");
+}
+
+void THROW(unsigned int exception) {
+    fprintf(stderr, "Unexpected exception 0x%04x\n", exception);
+    exit(EXIT_FAILURE);
+}
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <setjmp.h>
+#include <stdint.h>
+
+#include "app_globals.h"
+
+// os_lib_end jumps back here, as Exchange regains control on the device
+extern jmp_buf bench_lib_end;
+
+// Returned by hedera_get_public_key for every index
+extern const uint8_t bench_public_key[PUBKEY_LENGTH];
+
+// Every byte of the signature returned by hedera_sign
+#define BENCH_SIGNATURE_BYTE 0x5A
+
+// Length of the last reply sent with io_exchange
+extern unsigned short bench_reply_length;
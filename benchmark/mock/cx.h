@@ -0,0 +1,42 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Crypto types and calls referenced by the app code. The hashing calls only
+// serve the streamed and secp256k1 requests, which the swap never sends.
+
+typedef int cx_err_t;
+
+#define CX_OK 0x00000000
+#define CX_LAST (1 << 0)
+
+#define CX_SHA256_SIZE 32
+#define CX_SHA3_256_SIZE 32
+#define CX_SHA512_SIZE 64
+
+typedef struct {
+    uint8_t data[32];
+} cx_hash_t;
+
+typedef struct {
+    cx_hash_t header;
+    uint8_t state[200];
+} cx_sha512_t;
+
+typedef struct {
+    cx_hash_t header;
+    uint8_t state[100];
+} cx_sha256_t;
+
+typedef struct {
+    cx_hash_t header;
+    uint8_t state[200];
+} cx_sha3_t;
+
+cx_err_t cx_sha256_init_no_throw(cx_sha256_t *hash);
+
+cx_err_t cx_keccak_init_no_throw(cx_sha3_t *hash, size_t size);
+
+cx_err_t cx_hash_no_throw(cx_hash_t *hash, uint32_t mode, const uint8_t *in,
+                          size_t len, uint8_t *out, size_t out_len);
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+// Minimal Ledger OS shim for the host benchmarks
+
+#ifndef PIC
+#define PIC(x) (x)
+#endif
+
+#define UNUSED(x) (void)(x)
+
+static inline void PRINTF(const char* fmt, ...) { (void)fmt; }
+
+// Big-endian helpers used in app code
+#ifndef U2BE
+#define U2BE(buf, off) (((uint16_t)(buf)[(off)] << 8) | (uint16_t)(buf)[(off) + 1])
+#endif
+#ifndef U4BE
+#define U4BE(buf, off) ((U2BE(buf, off) << 16) | (U2BE(buf, off + 2) & 0xFFFF))
+#endif
+#ifndef U2LE
+#define U2LE(buf, off) ((uint16_t)(buf)[(off)] | ((uint16_t)(buf)[(off) + 1] << 8))
+#endif
+#ifndef U4LE
+#define U4LE(buf, off) ((uint32_t)U2LE(buf, off) | ((uint32_t)U2LE(buf, off + 2) << 16))
+#endif
+
+static inline void U2BE_ENCODE(uint8_t* buf, size_t off, uint16_t value) {
+    buf[off] = (uint8_t)(value >> 8);
+    buf[off + 1] = (uint8_t)value;
+}
+
+// The benchmark cannot wipe its own BSS
+static inline void os_explicit_zero_BSS_segment(void) {}
+
+// Returns to the benchmark loop, see bench_mock.c
+void __attribute__((noreturn)) os_lib_end(void);
+
+// Only reached on malformed input, which the benchmarks never send
+void __attribute__((noreturn)) THROW(unsigned int exception);
+
+#define EXCEPTION_IO_RESET 0x10
+
+// Only reached on a second swap signature, which the benchmarks never send
+void __attribute__((noreturn)) os_sched_exit(int exit_code);
+
+// Set by the Exchange library call, see bench_swap.c
+extern volatile bool G_called_from_swap;
+extern volatile bool G_swap_response_ready;
+
+#define OFFSET_LC 4
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <stdint.h>
+
+// APDU buffer and exchange of the IO layer, see bench_mock.c
+
+#define IO_APDU_BUFFER_SIZE 260
+
+#define CHANNEL_APDU 0
+#define IO_RETURN_AFTER_TX 0x20
+#define IO_ASYNCH_REPLY 0x10
+
+extern uint8_t G_io_apdu_buffer[IO_APDU_BUFFER_SIZE];
+
+unsigned short io_exchange(unsigned char channel, unsigned short tx_len);
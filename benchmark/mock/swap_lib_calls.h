@@ -0,0 +1,39 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Parameters of the Exchange library calls, as laid out by the SDK
+
+#define MAX_PRINTABLE_AMOUNT_SIZE 50
+
+typedef struct check_address_parameters_s {
+    const uint8_t *coin_configuration;
+    uint8_t coin_configuration_length;
+    const uint8_t *address_parameters;
+    uint8_t address_parameters_length;
+    const char *address_to_check;
+    const char *extra_id_to_check;
+    int result;
+} check_address_parameters_t;
+
+typedef struct get_printable_amount_parameters_s {
+    const uint8_t *coin_configuration;
+    uint8_t coin_configuration_length;
+    const uint8_t *amount;
+    uint8_t amount_length;
+    bool is_fee;
+    char printable_amount[MAX_PRINTABLE_AMOUNT_SIZE];
+} get_printable_amount_parameters_t;
+
+typedef struct create_transaction_parameters_s {
+    const uint8_t *coin_configuration;
+    uint8_t coin_configuration_length;
+    const uint8_t *amount;
+    uint8_t amount_length;
+    const uint8_t *fee_amount;
+    uint8_t fee_amount_length;
+    const char *destination_address;
+    const char *destination_address_extra_id;
+    uint8_t result;
+} create_transaction_parameters_t;
@@ -0,0 +1,4 @@
+#pragma once
+
+// G_called_from_swap and G_swap_response_ready are declared in os.h
+#include "os.h"
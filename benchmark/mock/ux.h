@@ -0,0 +1,3 @@
+#pragma once
+
+// Nothing from the UX layer is used by the swap entry points
@@ -9,7 +9,8 @@
 
 int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
 {
-    char output[256];
+    protobuf_field_t fields[PROTOBUF_MAX_PATHS];
+    uint64_t value;
     
     // Reject inputs that are too large to avoid timeouts
     if (size > MAX_PROTO_SIZE) {
@@ -29,8 +30,11 @@ int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
         // Limit field number to reasonable range
         field_number = field_number % 1000;
         
-        // Test extract_nested_string_field with various field numbers
-        extract_nested_string_field(data + 4, size - 4, field_number, output, sizeof(output));
+        // Test extract_fields with various field numbers
+        const protobuf_path_t path = {{15, field_number, 1}, 3};
+        if (extract_fields(data + 4, size - 4, &path, 1, fields)) {
+            protobuf_field_varint(&fields[0], &value);
+        }
     }
     
     // Test parse_field_tag functionality
@@ -48,20 +52,18 @@ int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
         }
     }
     
-    // Test with various target field numbers (common Hedera fields)
-    uint32_t test_fields[] = {1, 2, 3, 14, 15, 16, 20, 25};
-    size_t num_test_fields = sizeof(test_fields) / sizeof(test_fields[0]);
-    
-    for (size_t i = 0; i < num_test_fields; i++) {
-        extract_nested_string_field(data, size, test_fields[i], output, sizeof(output));
+    // Test with various target paths (common Hedera fields), resolved together
+    const protobuf_path_t test_paths[] = {
+        {{15, 14, 1}, 3}, {{15, 15, 1}, 3}, {{15, 21, 1}, 3}, {{15, 2}, 2},
+        {{3}, 1},         {{6}, 1},         {{11, 13}, 2},    {{14, 2, 1, 1}, 4},
+    };
+    size_t num_test_paths = sizeof(test_paths) / sizeof(test_paths[0]);
+
+    if (extract_fields(data, size, test_paths, num_test_paths, fields)) {
+        for (size_t i = 0; i < num_test_paths; i++) {
+            protobuf_field_varint(&fields[i], &value);
+        }
     }
     
-    // Test edge cases with different output buffer sizes
-    char small_output[4];
-    char large_output[1024];
-    
-    extract_nested_string_field(data, size, 14, small_output, sizeof(small_output));
-    extract_nested_string_field(data, size, 14, large_output, sizeof(large_output));
-    
     return 0;
 } 
\ No newline at end of file
@@ -0,0 +1,629 @@
+#!/usr/bin/env python3
+"""Generate a specialized protobuf decoder from the nanopb headers.
+
+pb_decode() interprets the field descriptors of a message at run time. This
+script reads the same descriptors, the *_FIELDLIST macros of the nanopb
+generated headers, and emits one decoding function per message reachable from
+the root messages: a switch on the field number storing straight into the
+struct. The result is meant to be identical to pb_decode(), including on
+malformed input; tests/unit/test_transaction_body_decode.c checks it.
+
+Usage:
+    generate_decoder.py [--proto-dir DIR] --output BASENAME ROOT_MESSAGE...
+
+Regenerate after the nanopb headers change (make c_pb does both).
+"""
+
+import argparse
+import glob
+import os
+import re
+import sys
+
+FIELDLIST_RE = re.compile(r"#define (\w+)_FIELDLIST\(X, a\) \\\n((?:X\(.*\n)+)")
+FIELD_RE = re.compile(
+    r"X\(a, (\w+),\s+(\w+),\s+(\w+),\s+(\(\w+,\w+,[\w.]+\)|\w+),\s+(\d+)\)")
+MACRO_RE = re.compile(r"#define (\w+)_(CALLBACK|DEFAULT) (\w+)")
+MSGTYPE_RE = re.compile(r"#define (\w+)_MSGTYPE (\w+)")
+
+VARINT_TYPES = {"BOOL", "INT32", "INT64", "UINT32", "UINT64", "SINT32", "SINT64"}
+FIXED_TYPES = {"FLOAT": "32", "DOUBLE": "64"}
+PACKABLE_TYPES = VARINT_TYPES | set(FIXED_TYPES)
+# MSG_W_CB: submessage with a message-level callback (submsg_callback option)
+MESSAGE_TYPES = {"MESSAGE", "MSG_W_CB"}
+
+
+class Field:
+    def __init__(self, message, atype, htype, ltype, name, tag):
+        self.message = message
+        self.atype = atype
+        self.htype = htype
+        self.ltype = ltype
+        self.tag = int(tag)
+        if name.startswith("("):
+            self.oneof, self.name, self.path = name[1:-1].split(",")
+            self.msgtype_key = "%s_%s_%s" % (message.name, self.oneof, self.name)
+        else:
+            self.oneof, self.name, self.path = None, name, name
+            self.msgtype_key = "%s_%s" % (message.name, self.name)
+        self.msgtype = None
+
+
+class Message:
+    def __init__(self, name, header):
+        self.name = name
+        self.header = header
+        self.fields = []
+        self.callback = "NULL"
+        self.default = "NULL"
+
+    def submessages(self):
+        return [f.msgtype for f in self.fields if f.ltype in MESSAGE_TYPES]
+
+    # Same condition as pb_field_set_to_default(): submessages without
+    # callbacks, defaults or submessages are simply zeroed
+    def needs_defaults(self):
+        return self.callback != "NULL" or self.default != "NULL" or \
+            bool(self.submessages())
+
+
+def parse_headers(proto_dir):
+    messages = {}
+    macros = {}
+    msgtypes = {}
+
+    for path in sorted(glob.glob(os.path.join(proto_dir, "*.pb.h"))):
+        with open(path) as header:
+            text = header.read()
+        for match in FIELDLIST_RE.finditer(text):
+            message = Message(match.group(1), os.path.basename(path))
+            for line in match.group(2).splitlines():
+                field = FIELD_RE.match(line.strip())
+                if not field:
+                    sys.exit("%s: cannot parse %r" % (path, line))
+                message.fields.append(Field(message, *field.groups()))
+            messages[message.name] = message
+        for match in MACRO_RE.finditer(text):
+            macros[(match.group(1), match.group(2))] = match.group(3)
+        for match in MSGTYPE_RE.finditer(text):
+            msgtypes[match.group(1)] = match.group(2)
+
+    for message in messages.values():
+        message.callback = macros.get((message.name, "CALLBACK"), "NULL")
+        message.default = macros.get((message.name, "DEFAULT"), "NULL")
+        for field in message.fields:
+            if field.ltype in MESSAGE_TYPES:
+                field.msgtype = msgtypes[field.msgtype_key]
+
+    return messages
+
+
+def reachable(messages, roots):
+    order = []
+    pending = list(roots)
+    while pending:
+        name = pending.pop(0)
+        if name in order:
+            continue
+        if name not in messages:
+            sys.exit("unknown message %s" % name)
+        order.append(name)
+        pending.extend(messages[name].submessages())
+    return [messages[name] for name in order]
+
+
+def check_supported(message):
+    if message.default != "NULL":
+        sys.exit("%s: default values are not supported" % message.name)
+    for field in message.fields:
+        supported = field.atype == "STATIC" and field.htype in (
+            "SINGULAR", "OPTIONAL", "REPEATED", "ONEOF") and (
+            field.ltype in VARINT_TYPES or field.ltype in FIXED_TYPES or
+            field.ltype in ("STRING", "BYTES") or field.ltype in MESSAGE_TYPES)
+        supported |= field.atype == "CALLBACK"
+        if not supported:
+            sys.exit("%s.%s: %s %s %s is not supported" % (
+                message.name, field.name, field.atype, field.htype,
+                field.ltype))
+
+
+def emit_set_defaults(message, out):
+    out.append("static void %s_set_defaults(%s *msg) {" % (
+        message.name, message.name))
+    oneofs_done = set()
+    for field in message.fields:
+        if field.atype == "CALLBACK":
+            out.append("    // %s: callbacks are kept" % field.name)
+            if all(f.atype == "CALLBACK" for f in message.fields):
+                out.append("    (void)msg;")
+            continue
+        if field.htype == "REPEATED":
+            out.append("    msg->%s_count = 0;" % field.name)
+            continue
+        if field.htype == "ONEOF":
+            if field.oneof not in oneofs_done:
+                out.append("    msg->which_%s = 0;" % field.oneof)
+                oneofs_done.add(field.oneof)
+            continue
+        if field.htype == "OPTIONAL":
+            out.append("    msg->has_%s = false;" % field.name)
+        if field.ltype in MESSAGE_TYPES and field.msgtype_message.needs_defaults():
+            out.append("    %s_set_defaults(&msg->%s);" % (
+                field.msgtype, field.path))
+        else:
+            out.append("    memset(&msg->%s, 0, sizeof(msg->%s));" % (
+                field.path, field.path))
+    out.append("}")
+    out.append("")
+
+
+def wire_type(field):
+    if field.ltype in VARINT_TYPES:
+        return "PB_WT_VARINT"
+    if field.ltype in FIXED_TYPES:
+        return "PB_WT_%sBIT" % FIXED_TYPES[field.ltype]
+    return "PB_WT_STRING"
+
+
+# Decode one value of the field at dest, wire type already checked
+def decode_value(field, dest, init, indent):
+    pad = " " * indent
+    ltype = field.ltype
+    # The callback is stored before the has_, count or which_ member, a
+    # singular field has none
+    if ltype == "MSG_W_CB" and field.htype != "SINGULAR":
+        return [pad + "if (!pbgen_decode_submessage_cb(stream, %s_decode_inner, %s, %s," % (
+            field.msgtype, dest, init),
+            pad + "                                &msg->cb_%s, %s_fields, msg, %d)) {" % (
+            field.oneof or field.name, field.message.name, field.tag),
+            pad + "    return false;",
+            pad + "}"]
+    if ltype in MESSAGE_TYPES:
+        return [pad + "if (!pbgen_decode_submessage(stream, %s_decode_inner, %s, %s)) {" % (
+            field.msgtype, dest, init),
+            pad + "    return false;",
+            pad + "}"]
+    if ltype == "STRING":
+        call = "pbgen_decode_string(stream, %s, sizeof(%s))" % (
+            dest[1:], dest[1:])
+    elif ltype == "BYTES":
+        call = "pbgen_decode_bytes(stream, (pb_bytes_array_t *)%s, sizeof(*%s))" % (
+            dest, dest)
+    elif ltype == "BOOL":
+        call = "pb_decode_bool(stream, %s)" % dest
+    elif ltype in ("UINT32", "UINT64", "INT32", "INT64", "SINT32", "SINT64"):
+        call = "pbgen_decode_%s(stream, %s)" % (ltype.lower(), dest)
+    else:
+        call = "pb_decode_fixed%s(stream, %s)" % (FIXED_TYPES[ltype], dest)
+    return [pad + "if (!%s) {" % call, pad + "    return false;", pad + "}"]
+
+
+def check_wire(field, indent):
+    pad = " " * indent
+    return [pad + "if (wire_type != %s) {" % wire_type(field),
+            pad + "    return false;",
+            pad + "}"]
+
+
+def emit_field(message, field, out):
+    pad = " " * 12
+    out.append("        case %d: // %s" % (field.tag, field.name))
+
+    if field.atype == "CALLBACK":
+        out.append(pad + "if (!pbgen_decode_callback(stream, wire_type, %s_fields, msg, %d)) {" % (
+            message.name, field.tag))
+        out.append(pad + "    return false;")
+        out.append(pad + "}")
+        out.append(pad + "break;")
+        return
+
+    if field.htype == "OPTIONAL":
+        out.append(pad + "msg->has_%s = true;" % field.name)
+        out += check_wire(field, 12)
+        out += decode_value(field, "&msg->%s" % field.path, "false", 12)
+    elif field.htype == "SINGULAR":
+        out += check_wire(field, 12)
+        out += decode_value(field, "&msg->%s" % field.path, "false", 12)
+    elif field.htype == "ONEOF":
+        which = "msg->which_%s" % field.oneof
+        if field.ltype in MESSAGE_TYPES:
+            out.append(pad + "if (%s != %d) {" % (which, field.tag))
+            out.append(pad + "    memset(&msg->%s, 0, sizeof(msg->%s));" % (
+                field.path, field.path))
+            if field.msgtype_message.needs_defaults():
+                out.append(pad + "    %s_set_defaults(&msg->%s);" % (
+                    field.msgtype, field.path))
+            out.append(pad + "}")
+        out.append(pad + "%s = %d;" % (which, field.tag))
+        out += check_wire(field, 12)
+        out += decode_value(field, "&msg->%s" % field.path, "false", 12)
+    else:
+        count = "msg->%s_count" % field.name
+        capacity = "pb_arraysize(%s, %s)" % (message.name, field.path)
+        out.append(pad + "{")
+        inner = " " * 16
+        if field.ltype in PACKABLE_TYPES:
+            out.append(inner + "if (wire_type == PB_WT_STRING) {")
+            out.append(inner + "    if (!pbgen_decode_packed_%s(stream, msg->%s, &%s, %s)) {" % (
+                field.ltype.lower(), field.path, count, capacity))
+            out.append(inner + "        return false;")
+            out.append(inner + "    }")
+            out.append(inner + "    break;")
+            out.append(inner + "}")
+        out.append(inner + "pb_size_t index = %s;" % count)
+        out.append(inner + "if (%s++ >= %s) {" % (count, capacity))
+        out.append(inner + "    return false;")
+        out.append(inner + "}")
+        out += check_wire(field, 16)
+        out += decode_value(field, "&msg->%s[index]" % field.path, "true", 16)
+        out.append(pad + "}")
+    out.append(pad + "break;")
+
+
+# Only the roots and the repeated submessages are decoded with init set, the
+# other submessages are initialized by their parent
+def emit_decode_inner(message, initialized, out):
+    out.append("static bool %s_decode_inner(pb_istream_t *stream, void *dest, bool init) {" %
+               message.name)
+    out.append("    %s *msg = dest;" % message.name)
+    out.append("")
+    if message.name in initialized:
+        out.append("    if (init) {")
+        out.append("        %s_set_defaults(msg);" % message.name)
+        out.append("    }")
+    else:
+        out.append("    (void)init;")
+    out.append("")
+    out.append("    while (stream->bytes_left) {")
+    out.append("        pb_wire_type_t wire_type;")
+    out.append("        uint32_t tag;")
+    out.append("        bool eof;")
+    out.append("")
+    out.append("        if (!pb_decode_tag(stream, &wire_type, &tag, &eof)) {")
+    out.append("            if (eof) {")
+    out.append("                break;")
+    out.append("            }")
+    out.append("            return false;")
+    out.append("        }")
+    out.append("")
+    out.append("        switch (tag) {")
+    out.append("        case 0:")
+    out.append("            return false;")
+    for field in sorted(message.fields, key=lambda f: f.tag):
+        emit_field(message, field, out)
+    out.append("        default:")
+    out.append("            if (!pb_skip_field(stream, wire_type)) {")
+    out.append("                return false;")
+    out.append("            }")
+    out.append("            break;")
+    out.append("        }")
+    out.append("    }")
+    out.append("")
+    out.append("    return true;")
+    out.append("}")
+    out.append("")
+
+
+RUNTIME = r'''// Same checks and stores as pb_dec_varint()
+static bool pbgen_decode_uint64(pb_istream_t *stream, uint64_t *dest) {
+    return pb_decode_varint(stream, dest);
+}
+
+static bool pbgen_decode_uint32(pb_istream_t *stream, uint32_t *dest) {
+    uint64_t value;
+    if (!pb_decode_varint(stream, &value)) {
+        return false;
+    }
+    *dest = (uint32_t)value;
+    return *dest == value;
+}
+
+static bool pbgen_decode_int64(pb_istream_t *stream, int64_t *dest) {
+    uint64_t value;
+    if (!pb_decode_varint(stream, &value)) {
+        return false;
+    }
+    *dest = (int64_t)value;
+    return true;
+}
+
+static bool pbgen_decode_int32(pb_istream_t *stream, int32_t *dest) {
+    uint64_t value;
+    if (!pb_decode_varint(stream, &value)) {
+        return false;
+    }
+    *dest = (int32_t)value;
+    return true;
+}
+
+static bool pbgen_decode_sint64(pb_istream_t *stream, int64_t *dest) {
+    return pb_decode_svarint(stream, dest);
+}
+
+static bool pbgen_decode_sint32(pb_istream_t *stream, int32_t *dest) {
+    int64_t value;
+    if (!pb_decode_svarint(stream, &value)) {
+        return false;
+    }
+    *dest = (int32_t)value;
+    return *dest == value;
+}
+
+// Same checks and stores as pb_dec_string()
+static bool pbgen_decode_string(pb_istream_t *stream, char *dest,
+                                size_t data_size) {
+    uint32_t size;
+    if (!pb_decode_varint32(stream, &size)) {
+        return false;
+    }
+    if (size == (uint32_t)-1 || (size_t)size + 1 > data_size) {
+        return false;
+    }
+    dest[size] = 0;
+    return pb_read(stream, (pb_byte_t *)dest, size);
+}
+
+// Same checks and stores as pb_dec_bytes()
+static bool pbgen_decode_bytes(pb_istream_t *stream, pb_bytes_array_t *dest,
+                               size_t data_size) {
+    uint32_t size;
+    if (!pb_decode_varint32(stream, &size)) {
+        return false;
+    }
+    if (size > PB_SIZE_MAX ||
+        PB_BYTES_ARRAY_T_ALLOCSIZE(size) > data_size) {
+        return false;
+    }
+    dest->size = (pb_size_t)size;
+    return pb_read(stream, dest->bytes, size);
+}
+
+// Same as pb_dec_submessage() for a static field
+static bool pbgen_decode_submessage(pb_istream_t *stream,
+                                    pbgen_decode_fn decode, void *dest,
+                                    bool init) {
+    pb_istream_t substream;
+    if (!pb_make_string_substream(stream, &substream)) {
+        return false;
+    }
+    bool status = decode(&substream, dest, init);
+    if (!pb_close_string_substream(stream, &substream)) {
+        return false;
+    }
+    return status;
+}
+
+// Same as pb_dec_submessage() for a static field with a message-level
+// callback, called before the submessage is decoded
+static bool pbgen_decode_submessage_cb(pb_istream_t *stream,
+                                       pbgen_decode_fn decode, void *dest,
+                                       bool init, pb_callback_t *callback,
+                                       const pb_msgdesc_t *fields, void *msg,
+                                       uint32_t tag) {
+    pb_istream_t substream;
+    bool status = true;
+    bool consumed = false;
+    if (!pb_make_string_substream(stream, &substream)) {
+        return false;
+    }
+    if (callback->funcs.decode) {
+        pb_field_iter_t iter;
+        if (!pb_field_iter_begin(&iter, fields, msg) ||
+            !pb_field_iter_find(&iter, tag)) {
+            return false;
+        }
+        status = callback->funcs.decode(&substream, &iter, &callback->arg);
+        consumed = substream.bytes_left == 0;
+    }
+    if (status && !consumed) {
+        status = decode(&substream, dest, init);
+    }
+    if (!pb_close_string_substream(stream, &substream)) {
+        return false;
+    }
+    return status;
+}
+
+// Same as decode_callback_field(), which the generic decoder runs for
+// callback fields
+static bool pbgen_decode_callback(pb_istream_t *stream,
+                                  pb_wire_type_t wire_type,
+                                  const pb_msgdesc_t *fields, void *msg,
+                                  uint32_t tag) {
+    pb_field_iter_t iter;
+    if (!pb_field_iter_begin(&iter, fields, msg) ||
+        !pb_field_iter_find(&iter, tag)) {
+        return false;
+    }
+
+    if (!iter.descriptor->field_callback) {
+        return pb_skip_field(stream, wire_type);
+    }
+    // Stored in flash, relocated as in the patched decode_callback_field()
+    pbgen_field_callback_fn callback =
+        (pbgen_field_callback_fn)PIC(iter.descriptor->field_callback);
+
+    if (wire_type == PB_WT_STRING) {
+        pb_istream_t substream;
+        size_t prev_bytes_left;
+
+        if (!pb_make_string_substream(stream, &substream)) {
+            return false;
+        }
+        do {
+            prev_bytes_left = substream.bytes_left;
+            if (!callback(&substream, NULL, &iter)) {
+                return false;
+            }
+        } while (substream.bytes_left > 0 &&
+                 substream.bytes_left < prev_bytes_left);
+        return pb_close_string_substream(stream, &substream);
+    }
+
+    // The scalar value is copied so that the callback sees its length
+    pb_byte_t buffer[10];
+    size_t size = 0;
+    switch (wire_type) {
+        case PB_WT_VARINT:
+            do {
+                if (size == sizeof(buffer) ||
+                    !pb_read(stream, buffer + size, 1)) {
+                    return false;
+                }
+            } while (buffer[size++] & 0x80);
+            break;
+        case PB_WT_64BIT:
+            size = 8;
+            if (!pb_read(stream, buffer, size)) {
+                return false;
+            }
+            break;
+        case PB_WT_32BIT:
+            size = 4;
+            if (!pb_read(stream, buffer, size)) {
+                return false;
+            }
+            break;
+        default:
+            return false;
+    }
+    pb_istream_t substream = pb_istream_from_buffer(buffer, size);
+    return callback(&substream, NULL, &iter);
+}
+'''
+
+PACKED_TEMPLATE = r'''
+// Same as the packed array path of decode_static_field()
+static bool pbgen_decode_packed_%(name)s(pb_istream_t *stream, %(ctype)s *array,
+                                  pb_size_t *count, pb_size_t capacity) {
+    pb_istream_t substream;
+    bool status = true;
+
+    if (!pb_make_string_substream(stream, &substream)) {
+        return false;
+    }
+    while (substream.bytes_left > 0 && *count < capacity) {
+        if (!%(decode)s(&substream, &array[*count])) {
+            status = false;
+            break;
+        }
+        (*count)++;
+    }
+    if (substream.bytes_left != 0) {
+        return false;
+    }
+    if (!pb_close_string_substream(stream, &substream)) {
+        return false;
+    }
+    return status;
+}
+'''
+
+CTYPES = {
+    "BOOL": ("bool", "pb_decode_bool"),
+    "INT32": ("int32_t", "pbgen_decode_int32"),
+    "INT64": ("int64_t", "pbgen_decode_int64"),
+    "UINT32": ("uint32_t", "pbgen_decode_uint32"),
+    "UINT64": ("uint64_t", "pbgen_decode_uint64"),
+    "SINT32": ("int32_t", "pbgen_decode_sint32"),
+    "SINT64": ("int64_t", "pbgen_decode_sint64"),
+    "FLOAT": ("float", "pb_decode_fixed32"),
+    "DOUBLE": ("double", "pb_decode_fixed64"),
+}
+
+
+def generate(messages, roots, basename):
+    selected = reachable(messages, roots)
+    for message in selected:
+        check_supported(message)
+        for field in message.fields:
+            if field.msgtype:
+                field.msgtype_message = messages[field.msgtype]
+
+    guard = "PB_%s_INCLUDED" % re.sub(r"\W", "_", os.path.basename(basename)).upper()
+    headers = sorted({messages[root].header for root in roots})
+
+    h = ["/* Automatically generated by generate_decoder.py, do not edit */",
+         "",
+         "#ifndef %s" % guard,
+         "#define %s" % guard,
+         "",
+         "#include <pb_decode.h>",
+         ""]
+    h += ['#include "%s"' % header for header in headers]
+    h.append("")
+    for root in roots:
+        h.append("// Same result as pb_decode(stream, %s_fields, dest)" % root)
+        h.append("bool %s_decode(pb_istream_t *stream, %s *dest);" % (root, root))
+        h.append("")
+    h.append("#endif")
+
+    c = ["/* Automatically generated by generate_decoder.py, do not edit */",
+         "",
+         '#include "%s.h"' % os.path.basename(basename),
+         "",
+         "#include <pb_common.h>",
+         "#include <string.h>",
+         "",
+         "typedef bool (*pbgen_decode_fn)(pb_istream_t *stream, void *dest, bool init);",
+         "typedef bool (*pbgen_field_callback_fn)(pb_istream_t *istream, pb_ostream_t *ostream,",
+         "                                        const pb_field_iter_t *field);",
+         "",
+         RUNTIME.rstrip("\n")]
+    packed = sorted({f.ltype for m in selected for f in m.fields
+                     if f.htype == "REPEATED" and f.ltype in PACKABLE_TYPES})
+    for ltype in packed:
+        ctype, decode = CTYPES[ltype]
+        c.append(PACKED_TEMPLATE.rstrip("\n") % {
+            "name": ltype.lower(), "ctype": ctype, "decode": decode})
+    c.append("")
+    for message in selected:
+        c.append("static bool %s_decode_inner(pb_istream_t *stream, void *dest, bool init);" %
+                 message.name)
+    c.append("")
+    initialized = set(roots) | {f.msgtype for m in selected for f in m.fields
+                                if f.htype == "REPEATED" and f.msgtype}
+    for message in selected:
+        if message.needs_defaults() or message.name in initialized:
+            c.append("static void %s_set_defaults(%s *msg);" % (message.name, message.name))
+    c.append("")
+    for message in selected:
+        if message.needs_defaults() or message.name in initialized:
+            emit_set_defaults(message, c)
+    for message in selected:
+        emit_decode_inner(message, initialized, c)
+    for root in roots:
+        c.append("bool %s_decode(pb_istream_t *stream, %s *dest) {" % (root, root))
+        c.append("    return %s_decode_inner(stream, dest, true);" % root)
+        c.append("}")
+        c.append("")
+
+    # Drop the helpers no field of these messages needs
+    body = "\n".join(c)
+    helpers = []
+    for block in re.split(r"(?<=\n})\n\n", RUNTIME.strip("\n")):
+        name = re.search(r"^static bool (\w+)\(", block, re.M)
+        if re.search(r"\b%s\b" % name.group(1),
+                                     body.replace(block, "")):
+            helpers.append(block)
+    c[c.index(RUNTIME.rstrip("\n"))] = "\n\n".join(helpers)
+
+    with open(basename + ".h", "w") as out:
+        out.write("\n".join(h) + "\n")
+    with open(basename + ".c", "w") as out:
+        out.write("\n".join(c).rstrip("\n") + "\n")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--proto-dir", default=os.path.dirname(os.path.abspath(__file__)))
+    parser.add_argument("--output", required=True,
+                        help="path of the generated files, without extension")
+    parser.add_argument("roots", nargs="+", help="messages with a public decoder")
+    args = parser.parse_args()
+
+    generate(parse_headers(args.proto_dir), args.roots, args.output)
+
+
+if __name__ == "__main__":
+    main()
@@ -52,6 +52,7 @@ typedef struct _Hedera_TransactionBody {
     char memo[100]; 
     /* *
  Call a contract */
+    pb_callback_t cb_data;
     pb_size_t which_data;
     union {
         Hedera_ContractCallTransactionBody contractCall;
@@ -71,8 +72,8 @@ extern "C" {
 #endif
 
 /* Initializer values for message structs */
-#define Hedera_TransactionBody_init_default      {false, Hedera_TransactionID_init_default, false, Hedera_AccountID_init_default, 0, false, Hedera_Duration_init_default, 0, "", 0, {Hedera_ContractCallTransactionBody_init_default}}
-#define Hedera_TransactionBody_init_zero         {false, Hedera_TransactionID_init_zero, false, Hedera_AccountID_init_zero, 0, false, Hedera_Duration_init_zero, 0, "", 0, {Hedera_ContractCallTransactionBody_init_zero}}
+#define Hedera_TransactionBody_init_default      {false, Hedera_TransactionID_init_default, false, Hedera_AccountID_init_default, 0, false, Hedera_Duration_init_default, 0, "", {{NULL}, NULL}, 0, {Hedera_ContractCallTransactionBody_init_default}}
+#define Hedera_TransactionBody_init_zero         {false, Hedera_TransactionID_init_zero, false, Hedera_AccountID_init_zero, 0, false, Hedera_Duration_init_zero, 0, "", {{NULL}, NULL}, 0, {Hedera_ContractCallTransactionBody_init_zero}}
 
 /* Field tags (for use in manual encoding/decoding) */
 #define Hedera_TransactionBody_transactionID_tag 1
@@ -101,7 +102,7 @@ X(a, STATIC,   SINGULAR, STRING,   memo,              6) \
 X(a, STATIC,   ONEOF,    MESSAGE,  (data,contractCall,data.contractCall),   7) \
 X(a, STATIC,   ONEOF,    MESSAGE,  (data,cryptoCreateAccount,data.cryptoCreateAccount),  11) \
 X(a, STATIC,   ONEOF,    MESSAGE,  (data,cryptoTransfer,data.cryptoTransfer),  14) \
-X(a, STATIC,   ONEOF,    MESSAGE,  (data,cryptoUpdateAccount,data.cryptoUpdateAccount),  15) \
+X(a, STATIC,   ONEOF,    MSG_W_CB, (data,cryptoUpdateAccount,data.cryptoUpdateAccount),  15) \
 X(a, STATIC,   ONEOF,    MESSAGE,  (data,tokenMint,data.tokenMint),  37) \
 X(a, STATIC,   ONEOF,    MESSAGE,  (data,tokenBurn,data.tokenBurn),  38) \
 X(a, STATIC,   ONEOF,    MESSAGE,  (data,tokenAssociate,data.tokenAssociate),  40) \
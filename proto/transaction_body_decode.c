@@ -0,0 +1,2274 @@
+/* Automatically generated by generate_decoder.py, do not edit */
+
+#include "transaction_body_decode.h"
+
+#include <pb_common.h>
+#include <string.h>
+
+typedef bool (*pbgen_decode_fn)(pb_istream_t *stream, void *dest, bool init);
+typedef bool (*pbgen_field_callback_fn)(pb_istream_t *istream, pb_ostream_t *ostream,
+                                        const pb_field_iter_t *field);
+
+// Same checks and stores as pb_dec_varint()
+static bool pbgen_decode_uint64(pb_istream_t *stream, uint64_t *dest) {
+    return pb_decode_varint(stream, dest);
+}
+
+static bool pbgen_decode_uint32(pb_istream_t *stream, uint32_t *dest) {
+    uint64_t value;
+    if (!pb_decode_varint(stream, &value)) {
+        return false;
+    }
+    *dest = (uint32_t)value;
+    return *dest == value;
+}
+
+static bool pbgen_decode_int64(pb_istream_t *stream, int64_t *dest) {
+    uint64_t value;
+    if (!pb_decode_varint(stream, &value)) {
+        return false;
+    }
+    *dest = (int64_t)value;
+    return true;
+}
+
+static bool pbgen_decode_int32(pb_istream_t *stream, int32_t *dest) {
+    uint64_t value;
+    if (!pb_decode_varint(stream, &value)) {
+        return false;
+    }
+    *dest = (int32_t)value;
+    return true;
+}
+
+static bool pbgen_decode_sint64(pb_istream_t *stream, int64_t *dest) {
+    return pb_decode_svarint(stream, dest);
+}
+
+// Same checks and stores as pb_dec_string()
+static bool pbgen_decode_string(pb_istream_t *stream, char *dest,
+                                size_t data_size) {
+    uint32_t size;
+    if (!pb_decode_varint32(stream, &size)) {
+        return false;
+    }
+    if (size == (uint32_t)-1 || (size_t)size + 1 > data_size) {
+        return false;
+    }
+    dest[size] = 0;
+    return pb_read(stream, (pb_byte_t *)dest, size);
+}
+
+// Same checks and stores as pb_dec_bytes()
+static bool pbgen_decode_bytes(pb_istream_t *stream, pb_bytes_array_t *dest,
+                               size_t data_size) {
+    uint32_t size;
+    if (!pb_decode_varint32(stream, &size)) {
+        return false;
+    }
+    if (size > PB_SIZE_MAX ||
+        PB_BYTES_ARRAY_T_ALLOCSIZE(size) > data_size) {
+        return false;
+    }
+    dest->size = (pb_size_t)size;
+    return pb_read(stream, dest->bytes, size);
+}
+
+// Same as pb_dec_submessage() for a static field
+static bool pbgen_decode_submessage(pb_istream_t *stream,
+                                    pbgen_decode_fn decode, void *dest,
+                                    bool init) {
+    pb_istream_t substream;
+    if (!pb_make_string_substream(stream, &substream)) {
+        return false;
+    }
+    bool status = decode(&substream, dest, init);
+    if (!pb_close_string_substream(stream, &substream)) {
+        return false;
+    }
+    return status;
+}
+
+// Same as pb_dec_submessage() for a static field with a message-level
+// callback, called before the submessage is decoded
+static bool pbgen_decode_submessage_cb(pb_istream_t *stream,
+                                       pbgen_decode_fn decode, void *dest,
+                                       bool init, pb_callback_t *callback,
+                                       const pb_msgdesc_t *fields, void *msg,
+                                       uint32_t tag) {
+    pb_istream_t substream;
+    bool status = true;
+    bool consumed = false;
+    if (!pb_make_string_substream(stream, &substream)) {
+        return false;
+    }
+    if (callback->funcs.decode) {
+        pb_field_iter_t iter;
+        if (!pb_field_iter_begin(&iter, fields, msg) ||
+            !pb_field_iter_find(&iter, tag)) {
+            return false;
+        }
+        status = callback->funcs.decode(&substream, &iter, &callback->arg);
+        consumed = substream.bytes_left == 0;
+    }
+    if (status && !consumed) {
+        status = decode(&substream, dest, init);
+    }
+    if (!pb_close_string_substream(stream, &substream)) {
+        return false;
+    }
+    return status;
+}
+
+// Same as decode_callback_field(), which the generic decoder runs for
+// callback fields
+static bool pbgen_decode_callback(pb_istream_t *stream,
+                                  pb_wire_type_t wire_type,
+                                  const pb_msgdesc_t *fields, void *msg,
+                                  uint32_t tag) {
+    pb_field_iter_t iter;
+    if (!pb_field_iter_begin(&iter, fields, msg) ||
+        !pb_field_iter_find(&iter, tag)) {
+        return false;
+    }
+
+    if (!iter.descriptor->field_callback) {
+        return pb_skip_field(stream, wire_type);
+    }
+    // Stored in flash, relocated as in the patched decode_callback_field()
+    pbgen_field_callback_fn callback =
+        (pbgen_field_callback_fn)PIC(iter.descriptor->field_callback);
+
+    if (wire_type == PB_WT_STRING) {
+        pb_istream_t substream;
+        size_t prev_bytes_left;
+
+        if (!pb_make_string_substream(stream, &substream)) {
+            return false;
+        }
+        do {
+            prev_bytes_left = substream.bytes_left;
+            if (!callback(&substream, NULL, &iter)) {
+                return false;
+            }
+        } while (substream.bytes_left > 0 &&
+                 substream.bytes_left < prev_bytes_left);
+        return pb_close_string_substream(stream, &substream);
+    }
+
+    // The scalar value is copied so that the callback sees its length
+    pb_byte_t buffer[10];
+    size_t size = 0;
+    switch (wire_type) {
+        case PB_WT_VARINT:
+            do {
+                if (size == sizeof(buffer) ||
+                    !pb_read(stream, buffer + size, 1)) {
+                    return false;
+                }
+            } while (buffer[size++] & 0x80);
+            break;
+        case PB_WT_64BIT:
+            size = 8;
+            if (!pb_read(stream, buffer, size)) {
+                return false;
+            }
+            break;
+        case PB_WT_32BIT:
+            size = 4;
+            if (!pb_read(stream, buffer, size)) {
+                return false;
+            }
+            break;
+        default:
+            return false;
+    }
+    pb_istream_t substream = pb_istream_from_buffer(buffer, size);
+    return callback(&substream, NULL, &iter);
+}
+
+// Same as the packed array path of decode_static_field()
+static bool pbgen_decode_packed_int64(pb_istream_t *stream, int64_t *array,
+                                  pb_size_t *count, pb_size_t capacity) {
+    pb_istream_t substream;
+    bool status = true;
+
+    if (!pb_make_string_substream(stream, &substream)) {
+        return false;
+    }
+    while (substream.bytes_left > 0 && *count < capacity) {
+        if (!pbgen_decode_int64(&substream, &array[*count])) {
+            status = false;
+            break;
+        }
+        (*count)++;
+    }
+    if (substream.bytes_left != 0) {
+        return false;
+    }
+    if (!pb_close_string_substream(stream, &substream)) {
+        return false;
+    }
+    return status;
+}
+
+static bool Hedera_TransactionBody_decode_inner(pb_istream_t *stream, void *dest, bool init);
+static bool Hedera_TransactionID_decode_inner(pb_istream_t *stream, void *dest, bool init);
+static bool Hedera_AccountID_decode_inner(pb_istream_t *stream, void *dest, bool init);
+static bool Hedera_Duration_decode_inner(pb_istream_t *stream, void *dest, bool init);
+static bool Hedera_ContractCallTransactionBody_decode_inner(pb_istream_t *stream, void *dest, bool init);
+static bool Hedera_CryptoCreateTransactionBody_decode_inner(pb_istream_t *stream, void *dest, bool init);
+static bool Hedera_CryptoTransferTransactionBody_decode_inner(pb_istream_t *stream, void *dest, bool init);
+static bool Hedera_CryptoUpdateTransactionBody_decode_inner(pb_istream_t *stream, void *dest, bool init);
+static bool Hedera_TokenMintTransactionBody_decode_inner(pb_istream_t *stream, void *dest, bool init);
+static bool Hedera_TokenBurnTransactionBody_decode_inner(pb_istream_t *stream, void *dest, bool init);
+static bool Hedera_TokenAssociateTransactionBody_decode_inner(pb_istream_t *stream, void *dest, bool init);
+static bool Hedera_TokenDissociateTransactionBody_decode_inner(pb_istream_t *stream, void *dest, bool init);
+static bool Hedera_Timestamp_decode_inner(pb_istream_t *stream, void *dest, bool init);
+static bool Hedera_ContractID_decode_inner(pb_istream_t *stream, void *dest, bool init);
+static bool Hedera_Key_decode_inner(pb_istream_t *stream, void *dest, bool init);
+static bool Hedera_ShardID_decode_inner(pb_istream_t *stream, void *dest, bool init);
+static bool Hedera_RealmID_decode_inner(pb_istream_t *stream, void *dest, bool init);
+static bool Hedera_TransferList_decode_inner(pb_istream_t *stream, void *dest, bool init);
+static bool Hedera_TokenTransferList_decode_inner(pb_istream_t *stream, void *dest, bool init);
+static bool Hedera_UInt64Value_decode_inner(pb_istream_t *stream, void *dest, bool init);
+static bool Hedera_BoolValue_decode_inner(pb_istream_t *stream, void *dest, bool init);
+static bool Hedera_StringValue_decode_inner(pb_istream_t *stream, void *dest, bool init);
+static bool Hedera_Int32Value_decode_inner(pb_istream_t *stream, void *dest, bool init);
+static bool Hedera_TokenID_decode_inner(pb_istream_t *stream, void *dest, bool init);
+static bool Hedera_AccountAmount_decode_inner(pb_istream_t *stream, void *dest, bool init);
+static bool Hedera_NftTransfer_decode_inner(pb_istream_t *stream, void *dest, bool init);
+static bool Hedera_UInt32Value_decode_inner(pb_istream_t *stream, void *dest, bool init);
+
+static void Hedera_TransactionBody_set_defaults(Hedera_TransactionBody *msg);
+static void Hedera_TransactionID_set_defaults(Hedera_TransactionID *msg);
+static void Hedera_ContractCallTransactionBody_set_defaults(Hedera_ContractCallTransactionBody *msg);
+static void Hedera_CryptoCreateTransactionBody_set_defaults(Hedera_CryptoCreateTransactionBody *msg);
+static void Hedera_CryptoTransferTransactionBody_set_defaults(Hedera_CryptoTransferTransactionBody *msg);
+static void Hedera_CryptoUpdateTransactionBody_set_defaults(Hedera_CryptoUpdateTransactionBody *msg);
+static void Hedera_TokenMintTransactionBody_set_defaults(Hedera_TokenMintTransactionBody *msg);
+static void Hedera_TokenBurnTransactionBody_set_defaults(Hedera_TokenBurnTransactionBody *msg);
+static void Hedera_TokenAssociateTransactionBody_set_defaults(Hedera_TokenAssociateTransactionBody *msg);
+static void Hedera_TokenDissociateTransactionBody_set_defaults(Hedera_TokenDissociateTransactionBody *msg);
+static void Hedera_Key_set_defaults(Hedera_Key *msg);
+static void Hedera_TransferList_set_defaults(Hedera_TransferList *msg);
+static void Hedera_TokenTransferList_set_defaults(Hedera_TokenTransferList *msg);
+static void Hedera_StringValue_set_defaults(Hedera_StringValue *msg);
+static void Hedera_TokenID_set_defaults(Hedera_TokenID *msg);
+static void Hedera_AccountAmount_set_defaults(Hedera_AccountAmount *msg);
+static void Hedera_NftTransfer_set_defaults(Hedera_NftTransfer *msg);
+
+static void Hedera_TransactionBody_set_defaults(Hedera_TransactionBody *msg) {
+    msg->has_transactionID = false;
+    Hedera_TransactionID_set_defaults(&msg->transactionID);
+    msg->has_nodeAccountID = false;
+    memset(&msg->nodeAccountID, 0, sizeof(msg->nodeAccountID));
+    memset(&msg->transactionFee, 0, sizeof(msg->transactionFee));
+    msg->has_transactionValidDuration = false;
+    memset(&msg->transactionValidDuration, 0, sizeof(msg->transactionValidDuration));
+    memset(&msg->generateRecord, 0, sizeof(msg->generateRecord));
+    memset(&msg->memo, 0, sizeof(msg->memo));
+    msg->which_data = 0;
+}
+
+static void Hedera_TransactionID_set_defaults(Hedera_TransactionID *msg) {
+    msg->has_transactionValidStart = false;
+    memset(&msg->transactionValidStart, 0, sizeof(msg->transactionValidStart));
+    msg->has_accountID = false;
+    memset(&msg->accountID, 0, sizeof(msg->accountID));
+    memset(&msg->scheduled, 0, sizeof(msg->scheduled));
+    memset(&msg->nonce, 0, sizeof(msg->nonce));
+}
+
+static void Hedera_ContractCallTransactionBody_set_defaults(Hedera_ContractCallTransactionBody *msg) {
+    msg->has_contractID = false;
+    memset(&msg->contractID, 0, sizeof(msg->contractID));
+    memset(&msg->gas, 0, sizeof(msg->gas));
+    memset(&msg->amount, 0, sizeof(msg->amount));
+    memset(&msg->functionParameters, 0, sizeof(msg->functionParameters));
+}
+
+static void Hedera_CryptoCreateTransactionBody_set_defaults(Hedera_CryptoCreateTransactionBody *msg) {
+    msg->has_key = false;
+    Hedera_Key_set_defaults(&msg->key);
+    memset(&msg->initialBalance, 0, sizeof(msg->initialBalance));
+    msg->has_proxyAccountID = false;
+    memset(&msg->proxyAccountID, 0, sizeof(msg->proxyAccountID));
+    memset(&msg->sendRecordThreshold, 0, sizeof(msg->sendRecordThreshold));
+    memset(&msg->receiveRecordThreshold, 0, sizeof(msg->receiveRecordThreshold));
+    memset(&msg->receiverSigRequired, 0, sizeof(msg->receiverSigRequired));
+    msg->has_autoRenewPeriod = false;
+    memset(&msg->autoRenewPeriod, 0, sizeof(msg->autoRenewPeriod));
+    msg->has_shardID = false;
+    memset(&msg->shardID, 0, sizeof(msg->shardID));
+    msg->has_realmID = false;
+    memset(&msg->realmID, 0, sizeof(msg->realmID));
+    msg->has_newRealmAdminKey = false;
+    Hedera_Key_set_defaults(&msg->newRealmAdminKey);
+    memset(&msg->memo, 0, sizeof(msg->memo));
+    memset(&msg->max_automatic_token_associations, 0, sizeof(msg->max_automatic_token_associations));
+    msg->which_staked_id = 0;
+    memset(&msg->decline_reward, 0, sizeof(msg->decline_reward));
+}
+
+static void Hedera_CryptoTransferTransactionBody_set_defaults(Hedera_CryptoTransferTransactionBody *msg) {
+    msg->has_transfers = false;
+    Hedera_TransferList_set_defaults(&msg->transfers);
+    msg->tokenTransfers_count = 0;
+}
+
+static void Hedera_CryptoUpdateTransactionBody_set_defaults(Hedera_CryptoUpdateTransactionBody *msg) {
+    msg->has_accountIDToUpdate = false;
+    memset(&msg->accountIDToUpdate, 0, sizeof(msg->accountIDToUpdate));
+    msg->has_key = false;
+    Hedera_Key_set_defaults(&msg->key);
+    msg->has_proxyAccountID = false;
+    memset(&msg->proxyAccountID, 0, sizeof(msg->proxyAccountID));
+    memset(&msg->proxyFraction, 0, sizeof(msg->proxyFraction));
+    msg->which_sendRecordThresholdField = 0;
+    msg->which_receiveRecordThresholdField = 0;
+    msg->has_autoRenewPeriod = false;
+    memset(&msg->autoRenewPeriod, 0, sizeof(msg->autoRenewPeriod));
+    msg->has_expirationTime = false;
+    memset(&msg->expirationTime, 0, sizeof(msg->expirationTime));
+    msg->which_receiverSigRequiredField = 0;
+    msg->has_memo = false;
+    Hedera_StringValue_set_defaults(&msg->memo);
+    msg->has_max_automatic_token_associations = false;
+    memset(&msg->max_automatic_token_associations, 0, sizeof(msg->max_automatic_token_associations));
+    msg->which_staked_id = 0;
+    msg->has_decline_reward = false;
+    memset(&msg->decline_reward, 0, sizeof(msg->decline_reward));
+}
+
+static void Hedera_TokenMintTransactionBody_set_defaults(Hedera_TokenMintTransactionBody *msg) {
+    msg->has_token = false;
+    memset(&msg->token, 0, sizeof(msg->token));
+    memset(&msg->amount, 0, sizeof(msg->amount));
+    msg->metadata_count = 0;
+}
+
+static void Hedera_TokenBurnTransactionBody_set_defaults(Hedera_TokenBurnTransactionBody *msg) {
+    msg->has_token = false;
+    memset(&msg->token, 0, sizeof(msg->token));
+    memset(&msg->amount, 0, sizeof(msg->amount));
+    msg->serialNumbers_count = 0;
+}
+
+static void Hedera_TokenAssociateTransactionBody_set_defaults(Hedera_TokenAssociateTransactionBody *msg) {
+    msg->has_account = false;
+    memset(&msg->account, 0, sizeof(msg->account));
+    msg->tokens_count = 0;
+}
+
+static void Hedera_TokenDissociateTransactionBody_set_defaults(Hedera_TokenDissociateTransactionBody *msg) {
+    msg->has_account = false;
+    memset(&msg->account, 0, sizeof(msg->account));
+    msg->tokens_count = 0;
+}
+
+static void Hedera_Key_set_defaults(Hedera_Key *msg) {
+    msg->which_key = 0;
+}
+
+static void Hedera_TransferList_set_defaults(Hedera_TransferList *msg) {
+    msg->accountAmounts_count = 0;
+}
+
+static void Hedera_TokenTransferList_set_defaults(Hedera_TokenTransferList *msg) {
+    msg->has_token = false;
+    memset(&msg->token, 0, sizeof(msg->token));
+    msg->transfers_count = 0;
+    msg->nftTransfers_count = 0;
+    msg->has_expected_decimals = false;
+    memset(&msg->expected_decimals, 0, sizeof(msg->expected_decimals));
+}
+
+static void Hedera_StringValue_set_defaults(Hedera_StringValue *msg) {
+    // value: callbacks are kept
+    (void)msg;
+}
+
+static void Hedera_TokenID_set_defaults(Hedera_TokenID *msg) {
+    memset(&msg->shardNum, 0, sizeof(msg->shardNum));
+    memset(&msg->realmNum, 0, sizeof(msg->realmNum));
+    memset(&msg->tokenNum, 0, sizeof(msg->tokenNum));
+}
+
+static void Hedera_AccountAmount_set_defaults(Hedera_AccountAmount *msg) {
+    msg->has_accountID = false;
+    memset(&msg->accountID, 0, sizeof(msg->accountID));
+    memset(&msg->amount, 0, sizeof(msg->amount));
+    memset(&msg->is_approval, 0, sizeof(msg->is_approval));
+}
+
+static void Hedera_NftTransfer_set_defaults(Hedera_NftTransfer *msg) {
+    msg->has_senderAccountID = false;
+    memset(&msg->senderAccountID, 0, sizeof(msg->senderAccountID));
+    msg->has_receiverAccountID = false;
+    memset(&msg->receiverAccountID, 0, sizeof(msg->receiverAccountID));
+    memset(&msg->serialNumber, 0, sizeof(msg->serialNumber));
+    memset(&msg->is_approval, 0, sizeof(msg->is_approval));
+}
+
+static bool Hedera_TransactionBody_decode_inner(pb_istream_t *stream, void *dest, bool init) {
+    Hedera_TransactionBody *msg = dest;
+
+    if (init) {
+        Hedera_TransactionBody_set_defaults(msg);
+    }
+
+    while (stream->bytes_left) {
+        pb_wire_type_t wire_type;
+        uint32_t tag;
+        bool eof;
+
+        if (!pb_decode_tag(stream, &wire_type, &tag, &eof)) {
+            if (eof) {
+                break;
+            }
+            return false;
+        }
+
+        switch (tag) {
+        case 0:
+            return false;
+        case 1: // transactionID
+            msg->has_transactionID = true;
+            if (wire_type != PB_WT_STRING) {
+                return false;
+            }
+            if (!pbgen_decode_submessage(stream, Hedera_TransactionID_decode_inner, &msg->transactionID, false)) {
+                return false;
+            }
+            break;
+        case 2: // nodeAccountID
+            msg->has_nodeAccountID = true;
+            if (wire_type != PB_WT_STRING) {
+                return false;
+            }
+            if (!pbgen_decode_submessage(stream, Hedera_AccountID_decode_inner, &msg->nodeAccountID, false)) {
+                return false;
+            }
+            break;
+        case 3: // transactionFee
+            if (wire_type != PB_WT_VARINT) {
+                return false;
+            }
+            if (!pbgen_decode_uint64(stream, &msg->transactionFee)) {
+                return false;
+            }
+            break;
+        case 4: // transactionValidDuration
+            msg->has_transactionValidDuration = true;
+            if (wire_type != PB_WT_STRING) {
+                return false;
+            }
+            if (!pbgen_decode_submessage(stream, Hedera_Duration_decode_inner, &msg->transactionValidDuration, false)) {
+                return false;
+            }
+            break;
+        case 5: // generateRecord
+            if (wire_type != PB_WT_VARINT) {
+                return false;
+            }
+            if (!pb_decode_bool(stream, &msg->generateRecord)) {
+                return false;
+            }
+            break;
+        case 6: // memo
+            if (wire_type != PB_WT_STRING) {
+                return false;
+            }
+            if (!pbgen_decode_string(stream, msg->memo, sizeof(msg->memo))) {
+                return false;
+            }
+            break;
+        case 7: // contractCall
+            if (msg->which_data != 7) {
+                memset(&msg->data.contractCall, 0, sizeof(msg->data.contractCall));
+                Hedera_ContractCallTransactionBody_set_defaults(&msg->data.contractCall);
+            }
+            msg->which_data = 7;
+            if (wire_type != PB_WT_STRING) {
+                return false;
+            }
+            if (!pbgen_decode_submessage(stream, Hedera_ContractCallTransactionBody_decode_inner, &msg->data.contractCall, false)) {
+                return false;
+            }
+            break;
+        case 11: // cryptoCreateAccount
+            if (msg->which_data != 11) {
+                memset(&msg->data.cryptoCreateAccount, 0, sizeof(msg->data.cryptoCreateAccount));
+                Hedera_CryptoCreateTransactionBody_set_defaults(&msg->data.cryptoCreateAccount);
+            }
+            msg->which_data = 11;
+            if (wire_type != PB_WT_STRING) {
+                return false;
+            }
+            if (!pbgen_decode_submessage(stream, Hedera_CryptoCreateTransactionBody_decode_inner, &msg->data.cryptoCreateAccount, false)) {
+                return false;
+            }
+            break;
+        case 14: // cryptoTransfer
+            if (msg->which_data != 14) {
+                memset(&msg->data.cryptoTransfer, 0, sizeof(msg->data.cryptoTransfer));
+                Hedera_CryptoTransferTransactionBody_set_defaults(&msg->data.cryptoTransfer);
+            }
+            msg->which_data = 14;
+            if (wire_type != PB_WT_STRING) {
+                return false;
+            }
+            if (!pbgen_decode_submessage(stream, Hedera_CryptoTransferTransactionBody_decode_inner, &msg->data.cryptoTransfer, false)) {
+                return false;
+            }
+            break;
+        case 15: // cryptoUpdateAccount
+            if (msg->which_data != 15) {
+                memset(&msg->data.cryptoUpdateAccount, 0, sizeof(msg->data.cryptoUpdateAccount));
+                Hedera_CryptoUpdateTransactionBody_set_defaults(&msg->data.cryptoUpdateAccount);
+            }
+            msg->which_data = 15;
+            if (wire_type != PB_WT_STRING) {
+                return false;
+            }
+            if (!pbgen_decode_submessage_cb(stream, Hedera_CryptoUpdateTransactionBody_decode_inner, &msg->data.cryptoUpdateAccount, false,
+                                            &msg->cb_data, Hedera_TransactionBody_fields, msg, 15)) {
+                return false;
+            }
+            break;
+        case 37: // tokenMint
+            if (msg->which_data != 37) {
+                memset(&msg->data.tokenMint, 0, sizeof(msg->data.tokenMint));
+                Hedera_TokenMintTransactionBody_set_defaults(&msg->data.tokenMint);
+            }
+            msg->which_data = 37;
+            if (wire_type != PB_WT_STRING) {
+                return false;
+            }
+            if (!pbgen_decode_submessage(stream, Hedera_TokenMintTransactionBody_decode_inner, &msg->data.tokenMint, false)) {
+                return false;
+            }
+            break;
+        case 38: // tokenBurn
+            if (msg->which_data != 38) {
+                memset(&msg->data.tokenBurn, 0, sizeof(msg->data.tokenBurn));
+                Hedera_TokenBurnTransactionBody_set_defaults(&msg->data.tokenBurn);
+            }
+            msg->which_data = 38;
+            if (wire_type != PB_WT_STRING) {
+                return false;
+            }
+            if (!pbgen_decode_submessage(stream, Hedera_TokenBurnTransactionBody_decode_inner, &msg->data.tokenBurn, false)) {
+                return false;
+            }
+            break;
+        case 40: // tokenAssociate
+            if (msg->which_data != 40) {
+                memset(&msg->data.tokenAssociate, 0, sizeof(msg->data.tokenAssociate));
+                Hedera_TokenAssociateTransactionBody_set_defaults(&msg->data.tokenAssociate);
+            }
+            msg->which_data = 40;
+            if (wire_type != PB_WT_STRING) {
+                return false;
+            }
+            if (!pbgen_decode_submessage(stream, Hedera_TokenAssociateTransactionBody_decode_inner, &msg->data.tokenAssociate, false)) {
+                return false;
+            }
+            break;
+        case 41: // tokenDissociate
+            if (msg->which_data != 41) {
+                memset(&msg->data.tokenDissociate, 0, sizeof(msg->data.tokenDissociate));
+                Hedera_TokenDissociateTransactionBody_set_defaults(&msg->data.tokenDissociate);
+            }
+            msg->which_data = 41;
+            if (wire_type != PB_WT_STRING) {
+                return false;
+            }
+            if (!pbgen_decode_submessage(stream, Hedera_TokenDissociateTransactionBody_decode_inner, &msg->data.tokenDissociate, false)) {
+                return false;
+            }
+            break;
+        default:
+            if (!pb_skip_field(stream, wire_type)) {
+                return false;
+            }
+            break;
+        }
+    }
+
+    return true;
+}
+
+static bool Hedera_TransactionID_decode_inner(pb_istream_t *stream, void *dest, bool init) {
+    Hedera_TransactionID *msg = dest;
+
+    (void)init;
+
+    while (stream->bytes_left) {
+        pb_wire_type_t wire_type;
+        uint32_t tag;
+        bool eof;
+
+        if (!pb_decode_tag(stream, &wire_type, &tag, &eof)) {
+            if (eof) {
+                break;
+            }
+            return false;
+        }
+
+        switch (tag) {
+        case 0:
+            return false;
+        case 1: // transactionValidStart
+            msg->has_transactionValidStart = true;
+            if (wire_type != PB_WT_STRING) {
+                return false;
+            }
+            if (!pbgen_decode_submessage(stream, Hedera_Timestamp_decode_inner, &msg->transactionValidStart, false)) {
+                return false;
+            }
+            break;
+        case 2: // accountID
+            msg->has_accountID = true;
+            if (wire_type != PB_WT_STRING) {
+                return false;
+            }
+            if (!pbgen_decode_submessage(stream, Hedera_AccountID_decode_inner, &msg->accountID, false)) {
+                return false;
+            }
+            break;
+        case 3: // scheduled
+            if (wire_type != PB_WT_VARINT) {
+                return false;
+            }
+            if (!pb_decode_bool(stream, &msg->scheduled)) {
+                return false;
+            }
+            break;
+        case 4: // nonce
+            if (wire_type != PB_WT_VARINT) {
+                return false;
+            }
+            if (!pbgen_decode_int32(stream, &msg->nonce)) {
+                return false;
+            }
+            break;
+        default:
+            if (!pb_skip_field(stream, wire_type)) {
+                return false;
+            }
+            break;
+        }
+    }
+
+    return true;
+}
+
+static bool Hedera_AccountID_decode_inner(pb_istream_t *stream, void *dest, bool init) {
+    Hedera_AccountID *msg = dest;
+
+    (void)init;
+
+    while (stream->bytes_left) {
+        pb_wire_type_t wire_type;
+        uint32_t tag;
+        bool eof;
+
+        if (!pb_decode_tag(stream, &wire_type, &tag, &eof)) {
+            if (eof) {
+                break;
+            }
+            return false;
+        }
+
+        switch (tag) {
+        case 0:
+            return false;
+        case 1: // shardNum
+            if (wire_type != PB_WT_VARINT) {
+                return false;
+            }
+            if (!pbgen_decode_int64(stream, &msg->shardNum)) {
+                return false;
+            }
+            break;
+        case 2: // realmNum
+            if (wire_type != PB_WT_VARINT) {
+                return false;
+            }
+            if (!pbgen_decode_int64(stream, &msg->realmNum)) {
+                return false;
+            }
+            break;
+        case 3: // accountNum
+            msg->which_account = 3;
+            if (wire_type != PB_WT_VARINT) {
+                return false;
+            }
+            if (!pbgen_decode_int64(stream, &msg->account.accountNum)) {
+                return false;
+            }
+            break;
+        case 4: // alias
+            msg->which_account = 4;
+            if (wire_type != PB_WT_STRING) {
+                return false;
+            }
+            if (!pbgen_decode_bytes(stream, (pb_bytes_array_t *)&msg->account.alias, sizeof(*&msg->account.alias))) {
+                return false;
+            }
+            break;
+        default:
+            if (!pb_skip_field(stream, wire_type)) {
+                return false;
+            }
+            break;
+        }
+    }
+
+    return true;
+}
+
+static bool Hedera_Duration_decode_inner(pb_istream_t *stream, void *dest, bool init) {
+    Hedera_Duration *msg = dest;
+
+    (void)init;
+
+    while (stream->bytes_left) {
+        pb_wire_type_t wire_type;
+        uint32_t tag;
+        bool eof;
+
+        if (!pb_decode_tag(stream, &wire_type, &tag, &eof)) {
+            if (eof) {
+                break;
+            }
+            return false;
+        }
+
+        switch (tag) {
+        case 0:
+            return false;
+        case 1: // seconds
+            if (wire_type != PB_WT_VARINT) {
+                return false;
+            }
+            if (!pbgen_decode_int64(stream, &msg->seconds)) {
+                return false;
+            }
+            break;
+        default:
+            if (!pb_skip_field(stream, wire_type)) {
+                return false;
+            }
+            break;
+        }
+    }
+
+    return true;
+}
+
+static bool Hedera_ContractCallTransactionBody_decode_inner(pb_istream_t *stream, void *dest, bool init) {
+    Hedera_ContractCallTransactionBody *msg = dest;
+
+    (void)init;
+
+    while (stream->bytes_left) {
+        pb_wire_type_t wire_type;
+        uint32_t tag;
+        bool eof;
+
+        if (!pb_decode_tag(stream, &wire_type, &tag, &eof)) {
+            if (eof) {
+                break;
+            }
+            return false;
+        }
+
+        switch (tag) {
+        case 0:
+            return false;
+        case 1: // contractID
+            msg->has_contractID = true;
+            if (wire_type != PB_WT_STRING) {
+                return false;
+            }
+            if (!pbgen_decode_submessage(stream, Hedera_ContractID_decode_inner, &msg->contractID, false)) {
+                return false;
+            }
+            break;
+        case 2: // gas
+            if (wire_type != PB_WT_VARINT) {
+                return false;
+            }
+            if (!pbgen_decode_int64(stream, &msg->gas)) {
+                return false;
+            }
+            break;
+        case 3: // amount
+            if (wire_type != PB_WT_VARINT) {
+                return false;
+            }
+            if (!pbgen_decode_int64(stream, &msg->amount)) {
+                return false;
+            }
+            break;
+        case 4: // functionParameters
+            if (wire_type != PB_WT_STRING) {
+                return false;
+            }
+            if (!pbgen_decode_bytes(stream, (pb_bytes_array_t *)&msg->functionParameters, sizeof(*&msg->functionParameters))) {
+                return false;
+            }
+            break;
+        default:
+            if (!pb_skip_field(stream, wire_type)) {
+                return false;
+            }
+            break;
+        }
+    }
+
+    return true;
+}
+
+static bool Hedera_CryptoCreateTransactionBody_decode_inner(pb_istream_t *stream, void *dest, bool init) {
+    Hedera_CryptoCreateTransactionBody *msg = dest;
+
+    (void)init;
+
+    while (stream->bytes_left) {
+        pb_wire_type_t wire_type;
+        uint32_t tag;
+        bool eof;
+
+        if (!pb_decode_tag(stream, &wire_type, &tag, &eof)) {
+            if (eof) {
+                break;
+            }
+            return false;
+        }
+
+        switch (tag) {
+        case 0:
+            return false;
+        case 1: // key
+            msg->has_key = true;
+            if (wire_type != PB_WT_STRING) {
+                return false;
+            }
+            if (!pbgen_decode_submessage(stream, Hedera_Key_decode_inner, &msg->key, false)) {
+                return false;
+            }
+            break;
+        case 2: // initialBalance
+            if (wire_type != PB_WT_VARINT) {
+                return false;
+            }
+            if (!pbgen_decode_uint64(stream, &msg->initialBalance)) {
+                return false;
+            }
+            break;
+        case 3: // proxyAccountID
+            msg->has_proxyAccountID = true;
+            if (wire_type != PB_WT_STRING) {
+                return false;
+            }
+            if (!pbgen_decode_submessage(stream, Hedera_AccountID_decode_inner, &msg->proxyAccountID, false)) {
+                return false;
+            }
+            break;
+        case 6: // sendRecordThreshold
+            if (wire_type != PB_WT_VARINT) {
+                return false;
+            }
+            if (!pbgen_decode_uint64(stream, &msg->sendRecordThreshold)) {
+                return false;
+            }
+            break;
+        case 7: // receiveRecordThreshold
+            if (wire_type != PB_WT_VARINT) {
+                return false;
+            }
+            if (!pbgen_decode_uint64(stream, &msg->receiveRecordThreshold)) {
+                return false;
+            }
+            break;
+        case 8: // receiverSigRequired
+            if (wire_type != PB_WT_VARINT) {
+                return false;
+            }
+            if (!pb_decode_bool(stream, &msg->receiverSigRequired)) {
+                return false;
+            }
+            break;
+        case 9: // autoRenewPeriod
+            msg->has_autoRenewPeriod = true;
+            if (wire_type != PB_WT_STRING) {
+                return false;
+            }
+            if (!pbgen_decode_submessage(stream, Hedera_Duration_decode_inner, &msg->autoRenewPeriod, false)) {
+                return false;
+            }
+            break;
+        case 10: // shardID
+            msg->has_shardID = true;
+            if (wire_type != PB_WT_STRING) {
+                return false;
+            }
+            if (!pbgen_decode_submessage(stream, Hedera_ShardID_decode_inner, &msg->shardID, false)) {
+                return false;
+            }
+            break;
+        case 11: // realmID
+            msg->has_realmID = true;
+            if (wire_type != PB_WT_STRING) {
+                return false;
+            }
+            if (!pbgen_decode_submessage(stream, Hedera_RealmID_decode_inner, &msg->realmID, false)) {
+                return false;
+            }
+            break;
+        case 12: // newRealmAdminKey
+            msg->has_newRealmAdminKey = true;
+            if (wire_type != PB_WT_STRING) {
+                return false;
+            }
+            if (!pbgen_decode_submessage(stream, Hedera_Key_decode_inner, &msg->newRealmAdminKey, false)) {
+                return false;
+            }
+            break;
+        case 13: // memo
+            if (wire_type != PB_WT_STRING) {
+                return false;
+            }
+            if (!pbgen_decode_string(stream, msg->memo, sizeof(msg->memo))) {
+                return false;
+            }
+            break;
+        case 14: // max_automatic_token_associations
+            if (wire_type != PB_WT_VARINT) {
+                return false;
+            }
+            if (!pbgen_decode_int32(stream, &msg->max_automatic_token_associations)) {
+                return false;
+            }
+            break;
+        case 15: // staked_account_id
+            if (msg->which_staked_id != 15) {
+                memset(&msg->staked_id.staked_account_id, 0, sizeof(msg->staked_id.staked_account_id));
+            }
+            msg->which_staked_id = 15;
+            if (wire_type != PB_WT_STRING) {
+                return false;
+            }
+            if (!pbgen_decode_submessage(stream, Hedera_AccountID_decode_inner, &msg->staked_id.staked_account_id, false)) {
+                return false;
+            }
+            break;
+        case 16: // staked_node_id
+            msg->which_staked_id = 16;
+            if (wire_type != PB_WT_VARINT) {
+                return false;
+            }
+            if (!pbgen_decode_int64(stream, &msg->staked_id.staked_node_id)) {
+                return false;
+            }
+            break;
+        case 17: // decline_reward
+            if (wire_type != PB_WT_VARINT) {
+                return false;
+            }
+            if (!pb_decode_bool(stream, &msg->decline_reward)) {
+                return false;
+            }
+            break;
+        default:
+            if (!pb_skip_field(stream, wire_type)) {
+                return false;
+            }
+            break;
+        }
+    }
+
+    return true;
+}
+
+static bool Hedera_CryptoTransferTransactionBody_decode_inner(pb_istream_t *stream, void *dest, bool init) {
+    Hedera_CryptoTransferTransactionBody *msg = dest;
+
+    (void)init;
+
+    while (stream->bytes_left) {
+        pb_wire_type_t wire_type;
+        uint32_t tag;
+        bool eof;
+
+        if (!pb_decode_tag(stream, &wire_type, &tag, &eof)) {
+            if (eof) {
+                break;
+            }
+            return false;
+        }
+
+        switch (tag) {
+        case 0:
+            return false;
+        case 1: // transfers
+            msg->has_transfers = true;
+            if (wire_type != PB_WT_STRING) {
+                return false;
+            }
+            if (!pbgen_decode_submessage(stream, Hedera_TransferList_decode_inner, &msg->transfers, false)) {
+                return false;
+            }
+            break;
+        case 2: // tokenTransfers
+            {
+                pb_size_t index = msg->tokenTransfers_count;
+                if (msg->tokenTransfers_count++ >= pb_arraysize(Hedera_CryptoTransferTransactionBody, tokenTransfers)) {
+                    return false;
+                }
+                if (wire_type != PB_WT_STRING) {
+                    return false;
+                }
+                if (!pbgen_decode_submessage(stream, Hedera_TokenTransferList_decode_inner, &msg->tokenTransfers[index], true)) {
+                    return false;
+                }
+            }
+            break;
+        default:
+            if (!pb_skip_field(stream, wire_type)) {
+                return false;
+            }
+            break;
+        }
+    }
+
+    return true;
+}
+
+static bool Hedera_CryptoUpdateTransactionBody_decode_inner(pb_istream_t *stream, void *dest, bool init) {
+    Hedera_CryptoUpdateTransactionBody *msg = dest;
+
+    (void)init;
+
+    while (stream->bytes_left) {
+        pb_wire_type_t wire_type;
+        uint32_t tag;
+        bool eof;
+
+        if (!pb_decode_tag(stream, &wire_type, &tag, &eof)) {
+            if (eof) {
+                break;
+            }
+            return false;
+        }
+
+        switch (tag) {
+        case 0:
+            return false;
+        case 2: // accountIDToUpdate
+            msg->has_accountIDToUpdate = true;
+            if (wire_type != PB_WT_STRING) {
+                return false;
+            }
+            if (!pbgen_decode_submessage(stream, Hedera_AccountID_decode_inner, &msg->accountIDToUpdate, false)) {
+                return false;
+            }
+            break;
+        case 3: // key
+            msg->has_key = true;
+            if (wire_type != PB_WT_STRING) {
+                return false;
+            }
+            if (!pbgen_decode_submessage(stream, Hedera_Key_decode_inner, &msg->key, false)) {
+                return false;
+            }
+            break;
+        case 4: // proxyAccountID
+            msg->has_proxyAccountID = true;
+            if (wire_type != PB_WT_STRING) {
+                return false;
+            }
+            if (!pbgen_decode_submessage(stream, Hedera_AccountID_decode_inner, &msg->proxyAccountID, false)) {
+                return false;
+            }
+            break;
+        case 5: // proxyFraction
+            if (wire_type != PB_WT_VARINT) {
+                return false;
+            }
+            if (!pbgen_decode_int32(stream, &msg->proxyFraction)) {
+                return false;
+            }
+            break;
+        case 6: // sendRecordThreshold
+            msg->which_sendRecordThresholdField = 6;
+            if (wire_type != PB_WT_VARINT) {
+                return false;
+            }
+            if (!pbgen_decode_uint64(stream, &msg->sendRecordThresholdField.sendRecordThreshold)) {
+                return false;
+            }
+            break;
+        case 7: // receiveRecordThreshold
+            msg->which_receiveRecordThresholdField = 7;
+            if (wire_type != PB_WT_VARINT) {
+                return false;
+            }
+            if (!pbgen_decode_uint64(stream, &msg->receiveRecordThresholdField.receiveRecordThreshold)) {
+                return false;
+            }
+            break;
+        case 8: // autoRenewPeriod
+            msg->has_autoRenewPeriod = true;
+            if (wire_type != PB_WT_STRING) {
+                return false;
+            }
+            if (!pbgen_decode_submessage(stream, Hedera_Duration_decode_inner, &msg->autoRenewPeriod, false)) {
+                return false;
+            }
+            break;
+        case 9: // expirationTime
+            msg->has_expirationTime = true;
+            if (wire_type != PB_WT_STRING) {
+                return false;
+            }
+            if (!pbgen_decode_submessage(stream, Hedera_Timestamp_decode_inner, &msg->expirationTime, false)) {
+                return false;
+            }
+            break;
+        case 10: // receiverSigRequired
+            msg->which_receiverSigRequiredField = 10;
+            if (wire_type != PB_WT_VARINT) {
+                return false;
+            }
+            if (!pb_decode_bool(stream, &msg->receiverSigRequiredField.receiverSigRequired)) {
+                return false;
+            }
+            break;
+        case 11: // sendRecordThresholdWrapper
+            if (msg->which_sendRecordThresholdField != 11) {
+                memset(&msg->sendRecordThresholdField.sendRecordThresholdWrapper, 0, sizeof(msg->sendRecordThresholdField.sendRecordThresholdWrapper));
+            }
+            msg->which_sendRecordThresholdField = 11;
+            if (wire_type != PB_WT_STRING) {
+                return false;
+            }
+            if (!pbgen_decode_submessage(stream, Hedera_UInt64Value_decode_inner, &msg->sendRecordThresholdField.sendRecordThresholdWrapper, false)) {
+                return false;
+            }
+            break;
+        case 12: // receiveRecordThresholdWrapper
+            if (msg->which_receiveRecordThresholdField != 12) {
+                memset(&msg->receiveRecordThresholdField.receiveRecordThresholdWrapper, 0, sizeof(msg->receiveRecordThresholdField.receiveRecordThresholdWrapper));
+            }
+            msg->which_receiveRecordThresholdField = 12;
+            if (wire_type != PB_WT_STRING) {
+                return false;
+            }
+            if (!pbgen_decode_submessage(stream, Hedera_UInt64Value_decode_inner, &msg->receiveRecordThresholdField.receiveRecordThresholdWrapper, false)) {
+                return false;
+            }
+            break;
+        case 13: // receiverSigRequiredWrapper
+            if (msg->which_receiverSigRequiredField != 13) {
+                memset(&msg->receiverSigRequiredField.receiverSigRequiredWrapper, 0, sizeof(msg->receiverSigRequiredField.receiverSigRequiredWrapper));
+            }
+            msg->which_receiverSigRequiredField = 13;
+            if (wire_type != PB_WT_STRING) {
+                return false;
+            }
+            if (!pbgen_decode_submessage(stream, Hedera_BoolValue_decode_inner, &msg->receiverSigRequiredField.receiverSigRequiredWrapper, false)) {
+                return false;
+            }
+            break;
+        case 14: // memo
+            msg->has_memo = true;
+            if (wire_type != PB_WT_STRING) {
+                return false;
+            }
+            if (!pbgen_decode_submessage(stream, Hedera_StringValue_decode_inner, &msg->memo, false)) {
+                return false;
+            }
+            break;
+        case 15: // max_automatic_token_associations
+            msg->has_max_automatic_token_associations = true;
+            if (wire_type != PB_WT_STRING) {
+                return false;
+            }
+            if (!pbgen_decode_submessage(stream, Hedera_Int32Value_decode_inner, &msg->max_automatic_token_associations, false)) {
+                return false;
+            }
+            break;
+        case 16: // staked_account_id
+            if (msg->which_staked_id != 16) {
+                memset(&msg->staked_id.staked_account_id, 0, sizeof(msg->staked_id.staked_account_id));
+            }
+            msg->which_staked_id = 16;
+            if (wire_type != PB_WT_STRING) {
+                return false;
+            }
+            if (!pbgen_decode_submessage(stream, Hedera_AccountID_decode_inner, &msg->staked_id.staked_account_id, false)) {
+                return false;
+            }
+            break;
+        case 17: // staked_node_id
+            msg->which_staked_id = 17;
+            if (wire_type != PB_WT_VARINT) {
+                return false;
+            }
+            if (!pbgen_decode_int64(stream, &msg->staked_id.staked_node_id)) {
+                return false;
+            }
+            break;
+        case 18: // decline_reward
+            msg->has_decline_reward = true;
+            if (wire_type != PB_WT_STRING) {
+                return false;
+            }
+            if (!pbgen_decode_submessage(stream, Hedera_BoolValue_decode_inner, &msg->decline_reward, false)) {
+                return false;
+            }
+            break;
+        default:
+            if (!pb_skip_field(stream, wire_type)) {
+                return false;
+            }
+            break;
+        }
+    }
+
+    return true;
+}
+
+static bool Hedera_TokenMintTransactionBody_decode_inner(pb_istream_t *stream, void *dest, bool init) {
+    Hedera_TokenMintTransactionBody *msg = dest;
+
+    (void)init;
+
+    while (stream->bytes_left) {
+        pb_wire_type_t wire_type;
+        uint32_t tag;
+        bool eof;
+
+        if (!pb_decode_tag(stream, &wire_type, &tag, &eof)) {
+            if (eof) {
+                break;
+            }
+            return false;
+        }
+
+        switch (tag) {
+        case 0:
+            return false;
+        case 1: // token
+            msg->has_token = true;
+            if (wire_type != PB_WT_STRING) {
+                return false;
+            }
+            if (!pbgen_decode_submessage(stream, Hedera_TokenID_decode_inner, &msg->token, false)) {
+                return false;
+            }
+            break;
+        case 2: // amount
+            if (wire_type != PB_WT_VARINT) {
+                return false;
+            }
+            if (!pbgen_decode_uint64(stream, &msg->amount)) {
+                return false;
+            }
+            break;
+        case 3: // metadata
+            {
+                pb_size_t index = msg->metadata_count;
+                if (msg->metadata_count++ >= pb_arraysize(Hedera_TokenMintTransactionBody, metadata)) {
+                    return false;
+                }
+                if (wire_type != PB_WT_STRING) {
+                    return false;
+                }
+                if (!pbgen_decode_bytes(stream, (pb_bytes_array_t *)&msg->metadata[index], sizeof(*&msg->metadata[index]))) {
+                    return false;
+                }
+            }
+            break;
+        default:
+            if (!pb_skip_field(stream, wire_type)) {
+                return false;
+            }
+            break;
+        }
+    }
+
+    return true;
+}
+
+static bool Hedera_TokenBurnTransactionBody_decode_inner(pb_istream_t *stream, void *dest, bool init) {
+    Hedera_TokenBurnTransactionBody *msg = dest;
+
+    (void)init;
+
+    while (stream->bytes_left) {
+        pb_wire_type_t wire_type;
+        uint32_t tag;
+        bool eof;
+
+        if (!pb_decode_tag(stream, &wire_type, &tag, &eof)) {
+            if (eof) {
+                break;
+            }
+            return false;
+        }
+
+        switch (tag) {
+        case 0:
+            return false;
+        case 1: // token
+            msg->has_token = true;
+            if (wire_type != PB_WT_STRING) {
+                return false;
+            }
+            if (!pbgen_decode_submessage(stream, Hedera_TokenID_decode_inner, &msg->token, false)) {
+                return false;
+            }
+            break;
+        case 2: // amount
+            if (wire_type != PB_WT_VARINT) {
+                return false;
+            }
+            if (!pbgen_decode_uint64(stream, &msg->amount)) {
+                return false;
+            }
+            break;
+        case 3: // serialNumbers
+            {
+                if (wire_type == PB_WT_STRING) {
+                    if (!pbgen_decode_packed_int64(stream, msg->serialNumbers, &msg->serialNumbers_count, pb_arraysize(Hedera_TokenBurnTransactionBody, serialNumbers))) {
+                        return false;
+                    }
+                    break;
+                }
+                pb_size_t index = msg->serialNumbers_count;
+                if (msg->serialNumbers_count++ >= pb_arraysize(Hedera_TokenBurnTransactionBody, serialNumbers)) {
+                    return false;
+                }
+                if (wire_type != PB_WT_VARINT) {
+                    return false;
+                }
+                if (!pbgen_decode_int64(stream, &msg->serialNumbers[index])) {
+                    return false;
+                }
+            }
+            break;
+        default:
+            if (!pb_skip_field(stream, wire_type)) {
+                return false;
+            }
+            break;
+        }
+    }
+
+    return true;
+}
+
+static bool Hedera_TokenAssociateTransactionBody_decode_inner(pb_istream_t *stream, void *dest, bool init) {
+    Hedera_TokenAssociateTransactionBody *msg = dest;
+
+    (void)init;
+
+    while (stream->bytes_left) {
+        pb_wire_type_t wire_type;
+        uint32_t tag;
+        bool eof;
+
+        if (!pb_decode_tag(stream, &wire_type, &tag, &eof)) {
+            if (eof) {
+                break;
+            }
+            return false;
+        }
+
+        switch (tag) {
+        case 0:
+            return false;
+        case 1: // account
+            msg->has_account = true;
+            if (wire_type != PB_WT_STRING) {
+                return false;
+            }
+            if (!pbgen_decode_submessage(stream, Hedera_AccountID_decode_inner, &msg->account, false)) {
+                return false;
+            }
+            break;
+        case 2: // tokens
+            {
+                pb_size_t index = msg->tokens_count;
+                if (msg->tokens_count++ >= pb_arraysize(Hedera_TokenAssociateTransactionBody, tokens)) {
+                    return false;
+                }
+                if (wire_type != PB_WT_STRING) {
+                    return false;
+                }
+                if (!pbgen_decode_submessage(stream, Hedera_TokenID_decode_inner, &msg->tokens[index], true)) {
+                    return false;
+                }
+            }
+            break;
+        default:
+            if (!pb_skip_field(stream, wire_type)) {
+                return false;
+            }
+            break;
+        }
+    }
+
+    return true;
+}
+
+static bool Hedera_TokenDissociateTransactionBody_decode_inner(pb_istream_t *stream, void *dest, bool init) {
+    Hedera_TokenDissociateTransactionBody *msg = dest;
+
+    (void)init;
+
+    while (stream->bytes_left) {
+        pb_wire_type_t wire_type;
+        uint32_t tag;
+        bool eof;
+
+        if (!pb_decode_tag(stream, &wire_type, &tag, &eof)) {
+            if (eof) {
+                break;
+            }
+            return false;
+        }
+
+        switch (tag) {
+        case 0:
+            return false;
+        case 1: // account
+            msg->has_account = true;
+            if (wire_type != PB_WT_STRING) {
+                return false;
+            }
+            if (!pbgen_decode_submessage(stream, Hedera_AccountID_decode_inner, &msg->account, false)) {
+                return false;
+            }
+            break;
+        case 2: // tokens
+            {
+                pb_size_t index = msg->tokens_count;
+                if (msg->tokens_count++ >= pb_arraysize(Hedera_TokenDissociateTransactionBody, tokens)) {
+                    return false;
+                }
+                if (wire_type != PB_WT_STRING) {
+                    return false;
+                }
+                if (!pbgen_decode_submessage(stream, Hedera_TokenID_decode_inner, &msg->tokens[index], true)) {
+                    return false;
+                }
+            }
+            break;
+        default:
+            if (!pb_skip_field(stream, wire_type)) {
+                return false;
+            }
+            break;
+        }
+    }
+
+    return true;
+}
+
+static bool Hedera_Timestamp_decode_inner(pb_istream_t *stream, void *dest, bool init) {
+    Hedera_Timestamp *msg = dest;
+
+    (void)init;
+
+    while (stream->bytes_left) {
+        pb_wire_type_t wire_type;
+        uint32_t tag;
+        bool eof;
+
+        if (!pb_decode_tag(stream, &wire_type, &tag, &eof)) {
+            if (eof) {
+                break;
+            }
+            return false;
+        }
+
+        switch (tag) {
+        case 0:
+            return false;
+        case 1: // seconds
+            if (wire_type != PB_WT_VARINT) {
+                return false;
+            }
+            if (!pbgen_decode_int64(stream, &msg->seconds)) {
+                return false;
+            }
+            break;
+        case 2: // nanos
+            if (wire_type != PB_WT_VARINT) {
+                return false;
+            }
+            if (!pbgen_decode_int32(stream, &msg->nanos)) {
+                return false;
+            }
+            break;
+        default:
+            if (!pb_skip_field(stream, wire_type)) {
+                return false;
+            }
+            break;
+        }
+    }
+
+    return true;
+}
+
+static bool Hedera_ContractID_decode_inner(pb_istream_t *stream, void *dest, bool init) {
+    Hedera_ContractID *msg = dest;
+
+    (void)init;
+
+    while (stream->bytes_left) {
+        pb_wire_type_t wire_type;
+        uint32_t tag;
+        bool eof;
+
+        if (!pb_decode_tag(stream, &wire_type, &tag, &eof)) {
+            if (eof) {
+                break;
+            }
+            return false;
+        }
+
+        switch (tag) {
+        case 0:
+            return false;
+        case 1: // shardNum
+            if (wire_type != PB_WT_VARINT) {
+                return false;
+            }
+            if (!pbgen_decode_int64(stream, &msg->shardNum)) {
+                return false;
+            }
+            break;
+        case 2: // realmNum
+            if (wire_type != PB_WT_VARINT) {
+                return false;
+            }
+            if (!pbgen_decode_int64(stream, &msg->realmNum)) {
+                return false;
+            }
+            break;
+        case 3: // contractNum
+            msg->which_contract = 3;
+            if (wire_type != PB_WT_VARINT) {
+                return false;
+            }
+            if (!pbgen_decode_int64(stream, &msg->contract.contractNum)) {
+                return false;
+            }
+            break;
+        case 4: // evm_address
+            msg->which_contract = 4;
+            if (wire_type != PB_WT_STRING) {
+                return false;
+            }
+            if (!pbgen_decode_bytes(stream, (pb_bytes_array_t *)&msg->contract.evm_address, sizeof(*&msg->contract.evm_address))) {
+                return false;
+            }
+            break;
+        default:
+            if (!pb_skip_field(stream, wire_type)) {
+                return false;
+            }
+            break;
+        }
+    }
+
+    return true;
+}
+
+static bool Hedera_Key_decode_inner(pb_istream_t *stream, void *dest, bool init) {
+    Hedera_Key *msg = dest;
+
+    (void)init;
+
+    while (stream->bytes_left) {
+        pb_wire_type_t wire_type;
+        uint32_t tag;
+        bool eof;
+
+        if (!pb_decode_tag(stream, &wire_type, &tag, &eof)) {
+            if (eof) {
+                break;
+            }
+            return false;
+        }
+
+        switch (tag) {
+        case 0:
+            return false;
+        case 1: // contractID
+            if (msg->which_key != 1) {
+                memset(&msg->key.contractID, 0, sizeof(msg->key.contractID));
+            }
+            msg->which_key = 1;
+            if (wire_type != PB_WT_STRING) {
+                return false;
+            }
+            if (!pbgen_decode_submessage(stream, Hedera_ContractID_decode_inner, &msg->key.contractID, false)) {
+                return false;
+            }
+            break;
+        case 2: // ed25519
+            msg->which_key = 2;
+            if (wire_type != PB_WT_STRING) {
+                return false;
+            }
+            if (!pbgen_decode_bytes(stream, (pb_bytes_array_t *)&msg->key.ed25519, sizeof(*&msg->key.ed25519))) {
+                return false;
+            }
+            break;
+        case 3: // RSA_3072
+            msg->which_key = 3;
+            if (wire_type != PB_WT_STRING) {
+                return false;
+            }
+            if (!pbgen_decode_bytes(stream, (pb_bytes_array_t *)&msg->key.RSA_3072, sizeof(*&msg->key.RSA_3072))) {
+                return false;
+            }
+            break;
+        case 4: // ECDSA_384
+            msg->which_key = 4;
+            if (wire_type != PB_WT_STRING) {
+                return false;
+            }
+            if (!pbgen_decode_bytes(stream, (pb_bytes_array_t *)&msg->key.ECDSA_384, sizeof(*&msg->key.ECDSA_384))) {
+                return false;
+            }
+            break;
+        case 7: // ECDSA_secp256k1
+            msg->which_key = 7;
+            if (wire_type != PB_WT_STRING) {
+                return false;
+            }
+            if (!pbgen_decode_bytes(stream, (pb_bytes_array_t *)&msg->key.ECDSA_secp256k1, sizeof(*&msg->key.ECDSA_secp256k1))) {
+                return false;
+            }
+            break;
+        case 8: // delegatable_contract_id
+            if (msg->which_key != 8) {
+                memset(&msg->key.delegatable_contract_id, 0, sizeof(msg->key.delegatable_contract_id));
+            }
+            msg->which_key = 8;
+            if (wire_type != PB_WT_STRING) {
+                return false;
+            }
+            if (!pbgen_decode_submessage(stream, Hedera_ContractID_decode_inner, &msg->key.delegatable_contract_id, false)) {
+                return false;
+            }
+            break;
+        default:
+            if (!pb_skip_field(stream, wire_type)) {
+                return false;
+            }
+            break;
+        }
+    }
+
+    return true;
+}
+
+static bool Hedera_ShardID_decode_inner(pb_istream_t *stream, void *dest, bool init) {
+    Hedera_ShardID *msg = dest;
+
+    (void)init;
+
+    while (stream->bytes_left) {
+        pb_wire_type_t wire_type;
+        uint32_t tag;
+        bool eof;
+
+        if (!pb_decode_tag(stream, &wire_type, &tag, &eof)) {
+            if (eof) {
+                break;
+            }
+            return false;
+        }
+
+        switch (tag) {
+        case 0:
+            return false;
+        case 1: // shardNum
+            if (wire_type != PB_WT_VARINT) {
+                return false;
+            }
+            if (!pbgen_decode_int64(stream, &msg->shardNum)) {
+                return false;
+            }
+            break;
+        default:
+            if (!pb_skip_field(stream, wire_type)) {
+                return false;
+            }
+            break;
+        }
+    }
+
+    return true;
+}
+
+static bool Hedera_RealmID_decode_inner(pb_istream_t *stream, void *dest, bool init) {
+    Hedera_RealmID *msg = dest;
+
+    (void)init;
+
+    while (stream->bytes_left) {
+        pb_wire_type_t wire_type;
+        uint32_t tag;
+        bool eof;
+
+        if (!pb_decode_tag(stream, &wire_type, &tag, &eof)) {
+            if (eof) {
+                break;
+            }
+            return false;
+        }
+
+        switch (tag) {
+        case 0:
+            return false;
+        case 1: // shardNum
+            if (wire_type != PB_WT_VARINT) {
+                return false;
+            }
+            if (!pbgen_decode_int64(stream, &msg->shardNum)) {
+                return false;
+            }
+            break;
+        case 2: // realmNum
+            if (wire_type != PB_WT_VARINT) {
+                return false;
+            }
+            if (!pbgen_decode_int64(stream, &msg->realmNum)) {
+                return false;
+            }
+            break;
+        default:
+            if (!pb_skip_field(stream, wire_type)) {
+                return false;
+            }
+            break;
+        }
+    }
+
+    return true;
+}
+
+static bool Hedera_TransferList_decode_inner(pb_istream_t *stream, void *dest, bool init) {
+    Hedera_TransferList *msg = dest;
+
+    (void)init;
+
+    while (stream->bytes_left) {
+        pb_wire_type_t wire_type;
+        uint32_t tag;
+        bool eof;
+
+        if (!pb_decode_tag(stream, &wire_type, &tag, &eof)) {
+            if (eof) {
+                break;
+            }
+            return false;
+        }
+
+        switch (tag) {
+        case 0:
+            return false;
+        case 1: // accountAmounts
+            {
+                pb_size_t index = msg->accountAmounts_count;
+                if (msg->accountAmounts_count++ >= pb_arraysize(Hedera_TransferList, accountAmounts)) {
+                    return false;
+                }
+                if (wire_type != PB_WT_STRING) {
+                    return false;
+                }
+                if (!pbgen_decode_submessage(stream, Hedera_AccountAmount_decode_inner, &msg->accountAmounts[index], true)) {
+                    return false;
+                }
+            }
+            break;
+        default:
+            if (!pb_skip_field(stream, wire_type)) {
+                return false;
+            }
+            break;
+        }
+    }
+
+    return true;
+}
+
+static bool Hedera_TokenTransferList_decode_inner(pb_istream_t *stream, void *dest, bool init) {
+    Hedera_TokenTransferList *msg = dest;
+
+    if (init) {
+        Hedera_TokenTransferList_set_defaults(msg);
+    }
+
+    while (stream->bytes_left) {
+        pb_wire_type_t wire_type;
+        uint32_t tag;
+        bool eof;
+
+        if (!pb_decode_tag(stream, &wire_type, &tag, &eof)) {
+            if (eof) {
+                break;
+            }
+            return false;
+        }
+
+        switch (tag) {
+        case 0:
+            return false;
+        case 1: // token
+            msg->has_token = true;
+            if (wire_type != PB_WT_STRING) {
+                return false;
+            }
+            if (!pbgen_decode_submessage(stream, Hedera_TokenID_decode_inner, &msg->token, false)) {
+                return false;
+            }
+            break;
+        case 2: // transfers
+            {
+                pb_size_t index = msg->transfers_count;
+                if (msg->transfers_count++ >= pb_arraysize(Hedera_TokenTransferList, transfers)) {
+                    return false;
+                }
+                if (wire_type != PB_WT_STRING) {
+                    return false;
+                }
+                if (!pbgen_decode_submessage(stream, Hedera_AccountAmount_decode_inner, &msg->transfers[index], true)) {
+                    return false;
+                }
+            }
+            break;
+        case 3: // nftTransfers
+            {
+                pb_size_t index = msg->nftTransfers_count;
+                if (msg->nftTransfers_count++ >= pb_arraysize(Hedera_TokenTransferList, nftTransfers)) {
+                    return false;
+                }
+                if (wire_type != PB_WT_STRING) {
+                    return false;
+                }
+                if (!pbgen_decode_submessage(stream, Hedera_NftTransfer_decode_inner, &msg->nftTransfers[index], true)) {
+                    return false;
+                }
+            }
+            break;
+        case 4: // expected_decimals
+            msg->has_expected_decimals = true;
+            if (wire_type != PB_WT_STRING) {
+                return false;
+            }
+            if (!pbgen_decode_submessage(stream, Hedera_UInt32Value_decode_inner, &msg->expected_decimals, false)) {
+                return false;
+            }
+            break;
+        default:
+            if (!pb_skip_field(stream, wire_type)) {
+                return false;
+            }
+            break;
+        }
+    }
+
+    return true;
+}
+
+static bool Hedera_UInt64Value_decode_inner(pb_istream_t *stream, void *dest, bool init) {
+    Hedera_UInt64Value *msg = dest;
+
+    (void)init;
+
+    while (stream->bytes_left) {
+        pb_wire_type_t wire_type;
+        uint32_t tag;
+        bool eof;
+
+        if (!pb_decode_tag(stream, &wire_type, &tag, &eof)) {
+            if (eof) {
+                break;
+            }
+            return false;
+        }
+
+        switch (tag) {
+        case 0:
+            return false;
+        case 1: // value
+            if (wire_type != PB_WT_VARINT) {
+                return false;
+            }
+            if (!pbgen_decode_uint64(stream, &msg->value)) {
+                return false;
+            }
+            break;
+        default:
+            if (!pb_skip_field(stream, wire_type)) {
+                return false;
+            }
+            break;
+        }
+    }
+
+    return true;
+}
+
+static bool Hedera_BoolValue_decode_inner(pb_istream_t *stream, void *dest, bool init) {
+    Hedera_BoolValue *msg = dest;
+
+    (void)init;
+
+    while (stream->bytes_left) {
+        pb_wire_type_t wire_type;
+        uint32_t tag;
+        bool eof;
+
+        if (!pb_decode_tag(stream, &wire_type, &tag, &eof)) {
+            if (eof) {
+                break;
+            }
+            return false;
+        }
+
+        switch (tag) {
+        case 0:
+            return false;
+        case 1: // value
+            if (wire_type != PB_WT_VARINT) {
+                return false;
+            }
+            if (!pb_decode_bool(stream, &msg->value)) {
+                return false;
+            }
+            break;
+        default:
+            if (!pb_skip_field(stream, wire_type)) {
+                return false;
+            }
+            break;
+        }
+    }
+
+    return true;
+}
+
+static bool Hedera_StringValue_decode_inner(pb_istream_t *stream, void *dest, bool init) {
+    Hedera_StringValue *msg = dest;
+
+    (void)init;
+
+    while (stream->bytes_left) {
+        pb_wire_type_t wire_type;
+        uint32_t tag;
+        bool eof;
+
+        if (!pb_decode_tag(stream, &wire_type, &tag, &eof)) {
+            if (eof) {
+                break;
+            }
+            return false;
+        }
+
+        switch (tag) {
+        case 0:
+            return false;
+        case 1: // value
+            if (!pbgen_decode_callback(stream, wire_type, Hedera_StringValue_fields, msg, 1)) {
+                return false;
+            }
+            break;
+        default:
+            if (!pb_skip_field(stream, wire_type)) {
+                return false;
+            }
+            break;
+        }
+    }
+
+    return true;
+}
+
+static bool Hedera_Int32Value_decode_inner(pb_istream_t *stream, void *dest, bool init) {
+    Hedera_Int32Value *msg = dest;
+
+    (void)init;
+
+    while (stream->bytes_left) {
+        pb_wire_type_t wire_type;
+        uint32_t tag;
+        bool eof;
+
+        if (!pb_decode_tag(stream, &wire_type, &tag, &eof)) {
+            if (eof) {
+                break;
+            }
+            return false;
+        }
+
+        switch (tag) {
+        case 0:
+            return false;
+        case 1: // value
+            if (wire_type != PB_WT_VARINT) {
+                return false;
+            }
+            if (!pbgen_decode_int32(stream, &msg->value)) {
+                return false;
+            }
+            break;
+        default:
+            if (!pb_skip_field(stream, wire_type)) {
+                return false;
+            }
+            break;
+        }
+    }
+
+    return true;
+}
+
+static bool Hedera_TokenID_decode_inner(pb_istream_t *stream, void *dest, bool init) {
+    Hedera_TokenID *msg = dest;
+
+    if (init) {
+        Hedera_TokenID_set_defaults(msg);
+    }
+
+    while (stream->bytes_left) {
+        pb_wire_type_t wire_type;
+        uint32_t tag;
+        bool eof;
+
+        if (!pb_decode_tag(stream, &wire_type, &tag, &eof)) {
+            if (eof) {
+                break;
+            }
+            return false;
+        }
+
+        switch (tag) {
+        case 0:
+            return false;
+        case 1: // shardNum
+            if (wire_type != PB_WT_VARINT) {
+                return false;
+            }
+            if (!pbgen_decode_int64(stream, &msg->shardNum)) {
+                return false;
+            }
+            break;
+        case 2: // realmNum
+            if (wire_type != PB_WT_VARINT) {
+                return false;
+            }
+            if (!pbgen_decode_int64(stream, &msg->realmNum)) {
+                return false;
+            }
+            break;
+        case 3: // tokenNum
+            if (wire_type != PB_WT_VARINT) {
+                return false;
+            }
+            if (!pbgen_decode_int64(stream, &msg->tokenNum)) {
+                return false;
+            }
+            break;
+        default:
+            if (!pb_skip_field(stream, wire_type)) {
+                return false;
+            }
+            break;
+        }
+    }
+
+    return true;
+}
+
+static bool Hedera_AccountAmount_decode_inner(pb_istream_t *stream, void *dest, bool init) {
+    Hedera_AccountAmount *msg = dest;
+
+    if (init) {
+        Hedera_AccountAmount_set_defaults(msg);
+    }
+
+    while (stream->bytes_left) {
+        pb_wire_type_t wire_type;
+        uint32_t tag;
+        bool eof;
+
+        if (!pb_decode_tag(stream, &wire_type, &tag, &eof)) {
+            if (eof) {
+                break;
+            }
+            return false;
+        }
+
+        switch (tag) {
+        case 0:
+            return false;
+        case 1: // accountID
+            msg->has_accountID = true;
+            if (wire_type != PB_WT_STRING) {
+                return false;
+            }
+            if (!pbgen_decode_submessage(stream, Hedera_AccountID_decode_inner, &msg->accountID, false)) {
+                return false;
+            }
+            break;
+        case 2: // amount
+            if (wire_type != PB_WT_VARINT) {
+                return false;
+            }
+            if (!pbgen_decode_sint64(stream, &msg->amount)) {
+                return false;
+            }
+            break;
+        case 3: // is_approval
+            if (wire_type != PB_WT_VARINT) {
+                return false;
+            }
+            if (!pb_decode_bool(stream, &msg->is_approval)) {
+                return false;
+            }
+            break;
+        default:
+            if (!pb_skip_field(stream, wire_type)) {
+                return false;
+            }
+            break;
+        }
+    }
+
+    return true;
+}
+
+static bool Hedera_NftTransfer_decode_inner(pb_istream_t *stream, void *dest, bool init) {
+    Hedera_NftTransfer *msg = dest;
+
+    if (init) {
+        Hedera_NftTransfer_set_defaults(msg);
+    }
+
+    while (stream->bytes_left) {
+        pb_wire_type_t wire_type;
+        uint32_t tag;
+        bool eof;
+
+        if (!pb_decode_tag(stream, &wire_type, &tag, &eof)) {
+            if (eof) {
+                break;
+            }
+            return false;
+        }
+
+        switch (tag) {
+        case 0:
+            return false;
+        case 1: // senderAccountID
+            msg->has_senderAccountID = true;
+            if (wire_type != PB_WT_STRING) {
+                return false;
+            }
+            if (!pbgen_decode_submessage(stream, Hedera_AccountID_decode_inner, &msg->senderAccountID, false)) {
+                return false;
+            }
+            break;
+        case 2: // receiverAccountID
+            msg->has_receiverAccountID = true;
+            if (wire_type != PB_WT_STRING) {
+                return false;
+            }
+            if (!pbgen_decode_submessage(stream, Hedera_AccountID_decode_inner, &msg->receiverAccountID, false)) {
+                return false;
+            }
+            break;
+        case 3: // serialNumber
+            if (wire_type != PB_WT_VARINT) {
+                return false;
+            }
+            if (!pbgen_decode_int64(stream, &msg->serialNumber)) {
+                return false;
+            }
+            break;
+        case 4: // is_approval
+            if (wire_type != PB_WT_VARINT) {
+                return false;
+            }
+            if (!pb_decode_bool(stream, &msg->is_approval)) {
+                return false;
+            }
+            break;
+        default:
+            if (!pb_skip_field(stream, wire_type)) {
+                return false;
+            }
+            break;
+        }
+    }
+
+    return true;
+}
+
+static bool Hedera_UInt32Value_decode_inner(pb_istream_t *stream, void *dest, bool init) {
+    Hedera_UInt32Value *msg = dest;
+
+    (void)init;
+
+    while (stream->bytes_left) {
+        pb_wire_type_t wire_type;
+        uint32_t tag;
+        bool eof;
+
+        if (!pb_decode_tag(stream, &wire_type, &tag, &eof)) {
+            if (eof) {
+                break;
+            }
+            return false;
+        }
+
+        switch (tag) {
+        case 0:
+            return false;
+        case 1: // value
+            if (wire_type != PB_WT_VARINT) {
+                return false;
+            }
+            if (!pbgen_decode_uint32(stream, &msg->value)) {
+                return false;
+            }
+            break;
+        default:
+            if (!pb_skip_field(stream, wire_type)) {
+                return false;
+            }
+            break;
+        }
+    }
+
+    return true;
+}
+
+bool Hedera_TransactionBody_decode(pb_istream_t *stream, Hedera_TransactionBody *dest) {
+    return Hedera_TransactionBody_decode_inner(stream, dest, true);
+}
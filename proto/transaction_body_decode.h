@@ -0,0 +1,13 @@
+/* Automatically generated by generate_decoder.py, do not edit */
+
+#ifndef PB_TRANSACTION_BODY_DECODE_INCLUDED
+#define PB_TRANSACTION_BODY_DECODE_INCLUDED
+
+#include <pb_decode.h>
+
+#include "transaction_body.pb.h"
+
+// Same result as pb_decode(stream, Hedera_TransactionBody_fields, dest)
+bool Hedera_TransactionBody_decode(pb_istream_t *stream, Hedera_TransactionBody *dest);
+
+#endif
@@ -3,10 +3,12 @@
 #include <swap_utils.h>
 
 get_public_key_context_t gpk_ctx;
+bulk_export_context_t gpks_ctx;
+bulk_export_context_t gevm_ctx;
 
 static bool get_pk() {
-    // Derive Key
-    if (!hedera_get_pubkey(gpk_ctx.key_index, gpk_ctx.raw_pubkey)) {
+    // Derive Key, or read it back from the cache
+    if (!hedera_get_public_key(gpk_ctx.key_index, gpk_ctx.raw_pubkey)) {
         return false;
     }
 
@@ -15,10 +17,7 @@ static bool get_pk() {
     }
 
     // Put Key bytes in APDU buffer
-    uint8_t key_buffer[33];
-    public_key_to_bytes(key_buffer, gpk_ctx.raw_pubkey);
-    memcpy(G_io_apdu_buffer, key_buffer, 32);
-    memcpy(gpk_ctx.raw_pubkey, key_buffer, 32);
+    memcpy(G_io_apdu_buffer, gpk_ctx.raw_pubkey, 32);
 
     // Populate Key Hex String
     bin2hex(gpk_ctx.full_key, G_io_apdu_buffer, 32);
@@ -75,3 +74,124 @@ void handle_get_public_key(uint8_t p1, uint8_t p2, uint8_t* buffer,
 
     *flags |= IO_ASYNCH_REPLY;
 }
+
+// Writes the exported value of one index
+typedef bool bulk_export_fn(uint32_t account, uint32_t change, uint32_t index,
+                            uint8_t* out);
+
+static bool export_public_key(uint32_t account, uint32_t change,
+                              uint32_t index, uint8_t* out) {
+    uint8_t raw_pubkey[RAW_PUBKEY_SIZE];
+
+    if (!hedera_get_pubkey_at(account, change, index, raw_pubkey)) {
+        return false;
+    }
+    public_key_to_bytes(out, raw_pubkey);
+    return true;
+}
+
+// Start or continue an export, answering with the next values back to back
+static void bulk_export(bulk_export_context_t* ctx, uint8_t p1,
+                        uint8_t* buffer, uint16_t len, uint16_t value_size,
+                        uint8_t max_values, bulk_export_fn* export_value) {
+    // Exchange only checks a single address
+    if (G_called_from_swap) {
+        THROW(EXCEPTION_MALFORMED_APDU);
+    }
+
+    switch (p1) {
+        case P1_KEYS_START:
+            if (buffer == NULL || (len != 2 * sizeof(uint32_t) &&
+                                   len != 4 * sizeof(uint32_t))) {
+                THROW(EXCEPTION_MALFORMED_APDU);
+            }
+            ctx->next_index = U4LE(buffer, 0);
+            ctx->remaining = U4LE(buffer, sizeof(uint32_t));
+            ctx->account = HEDERA_ACCOUNT;
+            ctx->change = HEDERA_CHANGE;
+            if (len == 4 * sizeof(uint32_t)) {
+                ctx->account = U4LE(buffer, 2 * sizeof(uint32_t));
+                ctx->change = U4LE(buffer, 3 * sizeof(uint32_t));
+            }
+
+            // Indices do not wrap around
+            if (ctx->remaining == 0 ||
+                ctx->remaining - 1 > UINT32_MAX - ctx->next_index) {
+                explicit_bzero(ctx, sizeof(*ctx));
+                THROW(EXCEPTION_MALFORMED_APDU);
+            }
+            break;
+
+        case P1_KEYS_NEXT:
+            if (len != 0 || ctx->remaining == 0) {
+                THROW(EXCEPTION_MALFORMED_APDU);
+            }
+            break;
+
+        default:
+            THROW(EXCEPTION_MALFORMED_APDU);
+    }
+
+    // Every index is exported once, so the values bypass the key cache, only
+    // the parent node is reused
+    uint16_t length = 0;
+    for (uint8_t i = 0; i < max_values && ctx->remaining > 0; i++) {
+        if (!export_value(ctx->account, ctx->change, ctx->next_index,
+                          G_io_apdu_buffer + length)) {
+            explicit_bzero(ctx, sizeof(*ctx));
+            MEMCLEAR(G_io_apdu_buffer);
+            THROW(EXCEPTION_INTERNAL);
+        }
+        length += value_size;
+
+        ctx->next_index++;
+        ctx->remaining--;
+    }
+
+    io_exchange_with_code(EXCEPTION_OK, length);
+}
+
+// Bulk Public Key Handler
+// Exports the keys of consecutive indices without any UI, packing several
+// of them per response.
+//
+// P1_KEYS_START:
+//   start index (4, LE) | count (4, LE)
+//   [ | account (4, LE) | change (4, LE) ]
+// Keys are exported from m/44'/3030'/account'/change', by default
+// m/44'/3030'/0'/0' like every other instruction.
+// P1_KEYS_NEXT, with no data, continues the export.
+// Each response holds the next keys (32 bytes each) back to back, up to
+// MAX_KEYS_PER_RESPONSE; the host keeps sending P1_KEYS_NEXT until it has
+// count keys.
+void handle_get_public_keys(uint8_t p1, uint8_t p2, uint8_t* buffer,
+                            uint16_t len,
+                            /* out */ volatile unsigned int* flags,
+                            /* out */ volatile unsigned int* tx) {
+    UNUSED(p2);
+    UNUSED(tx);
+
+    bulk_export(&gpks_ctx, p1, buffer, len, PUBKEY_LENGTH,
+                MAX_KEYS_PER_RESPONSE, export_public_key);
+
+    *flags |= IO_ASYNCH_REPLY;
+}
+
+// EVM Address Handler
+// Exports the EVM addresses (20 bytes) of the secp256k1 keys of consecutive
+// indices, i.e. the aliases of ECDSA accounts, without any UI.
+//
+// Same requests as INS_GET_PUBLIC_KEYS; each response holds up to
+// MAX_ADDRESSES_PER_RESPONSE addresses back to back.
+void handle_get_evm_addresses(uint8_t p1, uint8_t p2, uint8_t* buffer,
+                              uint16_t len,
+                              /* out */ volatile unsigned int* flags,
+                              /* out */ volatile unsigned int* tx) {
+    UNUSED(p2);
+    UNUSED(tx);
+
+    bulk_export(&gevm_ctx, p1, buffer, len, EVM_ADDRESS_SIZE,
+                MAX_ADDRESSES_PER_RESPONSE, hedera_get_evm_address_at);
+
+    *flags |= IO_ASYNCH_REPLY;
+}
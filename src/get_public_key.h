@@ -11,6 +11,15 @@
 #include "ui_common.h"
 #include "utils.h"
 
+// P1 of INS_GET_PUBLIC_KEYS and INS_GET_EVM_ADDRESSES
+#define P1_KEYS_START 0x00 // Start an export: start index and count
+#define P1_KEYS_NEXT 0x01  // Next keys of the export
+
+// 224 bytes of keys, or 240 bytes of addresses, and the status word fit a
+// short response
+#define MAX_KEYS_PER_RESPONSE 7
+#define MAX_ADDRESSES_PER_RESPONSE 12
+
 typedef struct get_public_key_context_s {
     uint32_t key_index;
 
@@ -26,3 +35,17 @@ typedef struct get_public_key_context_s {
 } get_public_key_context_t;
 
 extern get_public_key_context_t gpk_ctx;
+
+// Cursor of a bulk export (INS_GET_PUBLIC_KEYS, INS_GET_EVM_ADDRESSES)
+typedef struct bulk_export_context_s {
+    // Parent node of the exported keys
+    uint32_t account;
+    uint32_t change;
+
+    // Next key of the export, and how many are left
+    uint32_t next_index;
+    uint32_t remaining;
+} bulk_export_context_t;
+
+extern bulk_export_context_t gpks_ctx;
+extern bulk_export_context_t gevm_ctx;
@@ -7,6 +7,14 @@
 #define INS_GET_APP_CONFIGURATION 0x01
 #define INS_GET_PUBLIC_KEY 0x02
 #define INS_SIGN_TRANSACTION 0x04
+#define INS_SIGN_TRANSACTION_STREAM 0x05
+#define INS_SIGN_TRANSACTION_BATCH 0x06
+#define INS_SIGN_TRANSACTION_MULTI 0x07
+#define INS_SIGN_TRANSACTION_QUEUE 0x08
+#define INS_SIGN_TRANSACTION_TEMPLATE 0x09
+#define INS_VALIDATE_TRANSACTION 0x0A
+#define INS_GET_PUBLIC_KEYS 0x0B
+#define INS_GET_EVM_ADDRESSES 0x0C
 
 typedef void handler_fn_t(uint8_t p1, uint8_t p2, uint8_t* buffer, uint16_t len,
                           /* out */ volatile unsigned int* flags,
@@ -15,3 +23,11 @@ typedef void handler_fn_t(uint8_t p1, uint8_t p2, uint8_t* buffer, uint16_t len,
 extern handler_fn_t handle_get_app_configuration;
 extern handler_fn_t handle_get_public_key;
 extern handler_fn_t handle_sign_transaction;
+extern handler_fn_t handle_sign_transaction_stream;
+extern handler_fn_t handle_sign_transaction_batch;
+extern handler_fn_t handle_sign_transaction_multi;
+extern handler_fn_t handle_sign_transaction_queue;
+extern handler_fn_t handle_sign_transaction_template;
+extern handler_fn_t handle_validate_transaction;
+extern handler_fn_t handle_get_public_keys;
+extern handler_fn_t handle_get_evm_addresses;
@@ -4,51 +4,621 @@
 #include <os.h>
 #include <string.h>
 
-#include "crypto_helpers.h"
 #include "utils.h"
 #include <stddef.h>
 #include <stdbool.h>
 
-// Constructs the fixed Hedera derivation path: m/44'/3030'/0'/0'/index'
-// Used for transaction signing and public key operations
-// Only the index parameter varies; all other path components are hardcoded
-static void hedera_set_path(uint32_t index, uint32_t path[static 5]) {
-    path[0] = PATH_ZERO;   // 44'
-    path[1] = PATH_ONE;    // 3030'
-    path[2] = PATH_TWO;    // 0'
-    path[3] = PATH_THREE;  // 0'
-    path[4] = PATH_FOUR;   // index'
+// Constructs the path of the parent node: m/44'/3030'/account'/change'
+// The keys used for signing and public key operations are its hardened
+// children
+static void hedera_set_path(uint32_t account, uint32_t change,
+                            uint32_t path[static PARENT_PATH_LENGTH]) {
+    path[0] = PATH_ZERO;                // 44'
+    path[1] = PATH_ONE;                 // 3030'
+    path[2] = account | PATH_HARDENED;  // account'
+    path[3] = change | PATH_HARDENED;   // change'
+}
+
+// Parent node of the last derivation on each curve, so that another index
+// only costs one hardened step instead of the whole path
+typedef struct parent_node_s {
+    bool valid;
+    uint32_t account;
+    uint32_t change;
+    uint8_t private_key[2 * ED25519_SCALAR_SIZE];
+    uint8_t chain_code[ED25519_SCALAR_SIZE];
+} parent_node_t;
+
+static parent_node_t ed25519_node;   // SLIP-10
+static parent_node_t secp256k1_node; // BIP32
+
+// Expanded signing key kept between consecutive signatures on the same
+// index, so that a signature only costs r.B and the hashes of the message
+typedef struct leaf_key_s {
+    bool valid;
+    uint32_t index;
+    uint8_t signatures_left;
+    uint16_t idle_ticks;
+    uint8_t a[ED25519_SCALAR_SIZE];      // big endian, reduced mod L
+    uint8_t prefix[ED25519_SCALAR_SIZE]; // nonce prefix
+    uint8_t A[ED25519_POINT_SIZE];       // encoded public key
+} leaf_key_t;
+
+static leaf_key_t leaf_key;
+
+// Hardened child of a parent node: I = HMAC-SHA512(chain code,
+// 0x00 || private key || index'). The child key is the left half of I with
+// SLIP-10 (Ed25519), and the left half of I plus the parent key mod n with
+// BIP32 (secp256k1).
+static bool derive_child(cx_curve_t curve, const parent_node_t* node,
+                         uint32_t index,
+                         uint8_t key[static ED25519_SCALAR_SIZE]) {
+    cx_hmac_sha512_t hmac;
+    uint8_t data[1 + ED25519_SCALAR_SIZE + sizeof(uint32_t)];
+    uint8_t digest[CX_SHA512_SIZE];
+    uint8_t order[SECP256K1_SCALAR_SIZE];
+    bool ok = false;
+
+    data[0] = 0x00;
+    memcpy(data + 1, node->private_key, ED25519_SCALAR_SIZE);
+    U4BE_ENCODE(data, 1 + ED25519_SCALAR_SIZE, index | PATH_HARDENED);
+
+    if (CX_OK == cx_hmac_sha512_init_no_throw(&hmac, node->chain_code,
+                                              sizeof(node->chain_code)) &&
+        CX_OK == cx_hmac_no_throw((cx_hmac_t*)&hmac, CX_LAST, data,
+                                  sizeof(data), digest, sizeof(digest))) {
+        if (curve == CX_CURVE_Ed25519) {
+            memcpy(key, digest, ED25519_SCALAR_SIZE);
+            ok = true;
+        } else {
+            // Invalid for the (negligible) left halves at or above n, and
+            // for a zero key
+            ok = CX_OK == cx_ecdomain_parameter(curve, CX_CURVE_PARAM_Order,
+                                                order, sizeof(order)) &&
+                 memcmp(digest, order, sizeof(order)) < 0 &&
+                 CX_OK == cx_math_addm_no_throw(key, digest, node->private_key,
+                                                order, sizeof(order)) &&
+                 !cx_math_is_zero(key, SECP256K1_SCALAR_SIZE);
+        }
+    }
+
+    explicit_bzero(&hmac, sizeof(hmac));
+    explicit_bzero(data, sizeof(data));
+    explicit_bzero(digest, sizeof(digest));
+    return ok;
+}
+
+// Private key of m/44'/3030'/account'/change'/index' on curve
+static bool hedera_init_private_key(cx_curve_t curve, uint32_t account,
+                                    uint32_t change, uint32_t index,
+                                    cx_ecfp_256_private_key_t* private_key) {
+    uint32_t path[PARENT_PATH_LENGTH];
+    uint8_t key[ED25519_SCALAR_SIZE];
+    parent_node_t* node =
+        curve == CX_CURVE_Ed25519 ? &ed25519_node : &secp256k1_node;
+    bool ok = false;
+
+    // Nothing is kept while the device is locked
+    bool cacheable = os_global_pin_is_validated() == BOLOS_UX_OK;
+
+    if (!cacheable || !node->valid || node->account != account ||
+        node->change != change) {
+        explicit_bzero(node, sizeof(*node));
+        hedera_set_path(account, change, path);
+        if (CX_OK != os_derive_bip32_with_seed_no_throw(
+                         curve == CX_CURVE_Ed25519 ? HDW_ED25519_SLIP10
+                                                   : HDW_NORMAL,
+                         curve, path, PARENT_PATH_LENGTH, node->private_key,
+                         node->chain_code, NULL, 0)) {
+            explicit_bzero(node, sizeof(*node));
+            return false;
+        }
+        node->valid = true;
+        node->account = account;
+        node->change = change;
+    }
+
+    ok = derive_child(curve, node, index, key) &&
+         CX_OK == cx_ecfp_init_private_key_no_throw(curve, key, sizeof(key),
+                                                    private_key);
+
+    explicit_bzero(key, sizeof(key));
+    if (!cacheable) {
+        explicit_bzero(node, sizeof(*node));
+    }
+    return ok;
+}
+
+bool hedera_get_pubkey_at(uint32_t account, uint32_t change, uint32_t index,
+                          uint8_t raw_pubkey[static RAW_PUBKEY_SIZE]) {
+    cx_ecfp_256_private_key_t private_key;
+    cx_ecfp_256_public_key_t public_key;
+    bool ok = false;
+
+    if (hedera_init_private_key(CX_CURVE_Ed25519, account, change, index,
+                                &private_key) &&
+        CX_OK == cx_ecfp_generate_pair_no_throw(CX_CURVE_Ed25519, &public_key,
+                                                &private_key, true)) {
+        memcpy(raw_pubkey, public_key.W, RAW_PUBKEY_SIZE);
+        ok = true;
+    }
+
+    explicit_bzero(&private_key, sizeof(private_key));
+    return ok;
 }
 
 bool hedera_get_pubkey(uint32_t index, uint8_t raw_pubkey[static RAW_PUBKEY_SIZE]) {
-    uint32_t path[5];
+    return hedera_get_pubkey_at(HEDERA_ACCOUNT, HEDERA_CHANGE, index,
+                                raw_pubkey);
+}
+
+typedef struct pubkey_cache_entry_s {
+    uint32_t index;
+    uint8_t pubkey[PUBKEY_LENGTH];
+} pubkey_cache_entry_t;
+
+// Most recently used first
+static pubkey_cache_entry_t pubkey_cache[PUBKEY_CACHE_SIZE];
+static uint8_t pubkey_cache_count;
+
+typedef struct signature_cache_entry_s {
+    bool valid;
+    uint32_t index;
+    uint8_t body_hash[CX_SHA256_SIZE];
+    uint8_t signature[ED25519_SIGNATURE_SIZE];
+} signature_cache_entry_t;
+
+// Ring of approved bodies, the oldest one is replaced first
+static signature_cache_entry_t signature_cache[SIGNATURE_CACHE_SIZE];
+static uint8_t signature_cache_next;
+
+void hedera_cache_reset(void) {
+    MEMCLEAR(ed25519_node);
+    MEMCLEAR(secp256k1_node);
+    MEMCLEAR(leaf_key);
+    MEMCLEAR(pubkey_cache);
+    pubkey_cache_count = 0;
+    MEMCLEAR(signature_cache);
+    signature_cache_next = 0;
+}
+
+static bool hash_body(const uint8_t* tx, size_t tx_len,
+                      uint8_t hash[static CX_SHA256_SIZE]) {
+    cx_sha256_t sha256;
+
+    return CX_OK == cx_sha256_init_no_throw(&sha256) &&
+           CX_OK == cx_hash_no_throw(&sha256.header, CX_LAST, tx, tx_len,
+                                     hash, CX_SHA256_SIZE);
+}
+
+void hedera_signature_cache_add(uint32_t index, const uint8_t* tx,
+                                size_t tx_len,
+                                const uint8_t signature[static ED25519_SIGNATURE_SIZE]) {
+    signature_cache_entry_t* entry = &signature_cache[signature_cache_next];
 
-    hedera_set_path(index, path);
+    // Nothing is kept while the device is locked
+    if (os_global_pin_is_validated() != BOLOS_UX_OK) {
+        return;
+    }
+
+    if (!hash_body(tx, tx_len, entry->body_hash)) {
+        explicit_bzero(entry, sizeof(*entry));
+        return;
+    }
+    entry->index = index;
+    memcpy(entry->signature, signature, ED25519_SIGNATURE_SIZE);
+    entry->valid = true;
+
+    signature_cache_next = (signature_cache_next + 1) % SIGNATURE_CACHE_SIZE;
+}
+
+bool hedera_signature_cache_find(uint32_t index, const uint8_t* tx,
+                                 size_t tx_len,
+                                 /* out */ uint8_t signature[static ED25519_SIGNATURE_SIZE]) {
+    uint8_t body_hash[CX_SHA256_SIZE];
+
+    if (os_global_pin_is_validated() != BOLOS_UX_OK ||
+        !hash_body(tx, tx_len, body_hash)) {
+        return false;
+    }
+
+    for (uint8_t i = 0; i < SIGNATURE_CACHE_SIZE; i++) {
+        if (signature_cache[i].valid && signature_cache[i].index == index &&
+            memcmp(signature_cache[i].body_hash, body_hash,
+                   sizeof(body_hash)) == 0) {
+            memcpy(signature, signature_cache[i].signature,
+                   ED25519_SIGNATURE_SIZE);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// Move entry position to the front of the cache
+static void pubkey_cache_promote(uint8_t position) {
+    pubkey_cache_entry_t entry = pubkey_cache[position];
+
+    memmove(&pubkey_cache[1], &pubkey_cache[0],
+            position * sizeof(pubkey_cache_entry_t));
+    pubkey_cache[0] = entry;
+}
+
+bool hedera_get_public_key(uint32_t index,
+                           uint8_t pubkey[static PUBKEY_LENGTH]) {
+    uint8_t raw_pubkey[RAW_PUBKEY_SIZE];
 
-    if (CX_OK != bip32_derive_with_seed_get_pubkey_256(
-                     HDW_ED25519_SLIP10, CX_CURVE_Ed25519, path, 5, raw_pubkey,
-                     NULL, CX_SHA512, NULL, 0)) {
+    // Nothing is served, nor kept, while the device is locked
+    bool cacheable = os_global_pin_is_validated() == BOLOS_UX_OK;
+    if (!cacheable) {
+        hedera_cache_reset();
+    }
+
+    for (uint8_t i = 0; cacheable && i < pubkey_cache_count; i++) {
+        if (pubkey_cache[i].index == index) {
+            pubkey_cache_promote(i);
+            memcpy(pubkey, pubkey_cache[0].pubkey, PUBKEY_LENGTH);
+            return true;
+        }
+    }
+
+    if (!hedera_get_pubkey(index, raw_pubkey)) {
         return false;
     }
+    public_key_to_bytes(pubkey, raw_pubkey);
+
+    if (cacheable) {
+        // The least recently used entry makes room when the cache is full
+        if (pubkey_cache_count < PUBKEY_CACHE_SIZE) {
+            pubkey_cache_count++;
+        }
+        pubkey_cache[pubkey_cache_count - 1].index = index;
+        memcpy(pubkey_cache[pubkey_cache_count - 1].pubkey, pubkey,
+               PUBKEY_LENGTH);
+        pubkey_cache_promote(pubkey_cache_count - 1);
+    }
 
     return true;
 }
 
-bool hedera_sign(uint32_t index, const uint8_t* tx, uint8_t tx_len,
+bool hedera_sign(uint32_t index, const uint8_t* tx, size_t tx_len,
                  /* out */ uint8_t* result, /* out */ size_t* sig_len_out) {
-    uint32_t path[5];
-    size_t sig_len = 64;
+    cx_ecfp_256_private_key_t private_key;
+    bool ok = false;
+
+    if (hedera_init_private_key(CX_CURVE_Ed25519, HEDERA_ACCOUNT,
+                                HEDERA_CHANGE, index, &private_key) &&
+        CX_OK == cx_eddsa_sign_no_throw(&private_key, CX_SHA512, tx, tx_len,
+                                        result, ED25519_SIGNATURE_SIZE)) {
+        if (sig_len_out) *sig_len_out = ED25519_SIGNATURE_SIZE;
+        ok = true;
+    }
 
-    hedera_set_path(index, path);
+    explicit_bzero(&private_key, sizeof(private_key));
+    return ok;
+}
 
-    if (CX_OK != bip32_derive_with_seed_eddsa_sign_hash_256(
-                     HDW_ED25519_SLIP10, CX_CURVE_Ed25519, path, 5, CX_SHA512,
-                     tx,     // hash (really message)
-                     tx_len, // hash length (really message length)
-                     result, // signature
-                     &sig_len, NULL, 0)) {
+bool hedera_sign_with_pubkey(uint32_t index, const uint8_t* tx, size_t tx_len,
+                             /* out */ uint8_t* result,
+                             /* out */ size_t* sig_len_out,
+                             /* out */ uint8_t pubkey[static PUBKEY_LENGTH]) {
+    cx_ecfp_256_private_key_t private_key;
+    cx_ecfp_256_public_key_t public_key;
+    bool ok = false;
+
+    // A single derivation for both the signature and the public key
+    if (hedera_init_private_key(CX_CURVE_Ed25519, HEDERA_ACCOUNT,
+                                HEDERA_CHANGE, index, &private_key) &&
+        CX_OK == cx_ecfp_generate_pair_no_throw(CX_CURVE_Ed25519, &public_key,
+                                                &private_key, true) &&
+        CX_OK == cx_eddsa_sign_no_throw(&private_key, CX_SHA512, tx, tx_len,
+                                        result, ED25519_SIGNATURE_SIZE)) {
+        public_key_to_bytes(pubkey, public_key.W);
+        if (sig_len_out) *sig_len_out = ED25519_SIGNATURE_SIZE;
+        ok = true;
+    }
+
+    explicit_bzero(&private_key, sizeof(private_key));
+    return ok;
+}
+
+// Replace s by n - s when it is the larger of the two, as most secp256k1
+// verifiers expect
+static bool ecdsa_normalize_s(uint8_t s[static SECP256K1_SCALAR_SIZE]) {
+    uint8_t order[SECP256K1_SCALAR_SIZE];
+    uint8_t negated[SECP256K1_SCALAR_SIZE];
+
+    if (CX_OK != cx_ecdomain_parameter(CX_CURVE_SECP256K1,
+                                       CX_CURVE_PARAM_Order, order,
+                                       sizeof(order)) ||
+        CX_OK != cx_math_sub_no_throw(negated, order, s, sizeof(negated))) {
         return false;
     }
-    if (sig_len_out) *sig_len_out = sig_len;
+
+    // Big endian, so the byte order is the numeric order
+    if (memcmp(s, negated, SECP256K1_SCALAR_SIZE) > 0) {
+        memcpy(s, negated, SECP256K1_SCALAR_SIZE);
+    }
     return true;
 }
+
+bool hedera_sign_ecdsa(uint32_t index,
+                       const uint8_t digest[static SECP256K1_SCALAR_SIZE],
+                       /* out */ uint8_t* result,
+                       /* out */ size_t* sig_len_out) {
+    cx_ecfp_256_private_key_t private_key;
+    uint32_t info = 0;
+    bool ok = false;
+
+    if (hedera_init_private_key(CX_CURVE_SECP256K1, HEDERA_ACCOUNT,
+                                HEDERA_CHANGE, index, &private_key) &&
+        CX_OK == cx_ecdsa_sign_rs_no_throw(
+                     &private_key, CX_RND_RFC6979 | CX_LAST, CX_SHA256, digest,
+                     SECP256K1_SCALAR_SIZE, SECP256K1_SCALAR_SIZE, result,
+                     result + SECP256K1_SCALAR_SIZE, &info) &&
+        ecdsa_normalize_s(result + SECP256K1_SCALAR_SIZE)) {
+        if (sig_len_out) *sig_len_out = 2 * SECP256K1_SCALAR_SIZE;
+        ok = true;
+    }
+
+    explicit_bzero(&private_key, sizeof(private_key));
+    return ok;
+}
+
+bool hedera_get_evm_address_at(uint32_t account, uint32_t change,
+                               uint32_t index,
+                               uint8_t address[static EVM_ADDRESS_SIZE]) {
+    cx_ecfp_256_private_key_t private_key;
+    cx_ecfp_256_public_key_t public_key;
+    cx_sha3_t hash;
+    uint8_t digest[CX_SHA3_256_SIZE];
+    bool ok = false;
+
+    // Last 20 bytes of the Keccak-256 of the uncompressed point X || Y
+    if (hedera_init_private_key(CX_CURVE_SECP256K1, account, change, index,
+                                &private_key) &&
+        CX_OK == cx_ecfp_generate_pair_no_throw(CX_CURVE_SECP256K1,
+                                                &public_key, &private_key,
+                                                true) &&
+        CX_OK == cx_keccak_init_no_throw(&hash, 256) &&
+        CX_OK == cx_hash_no_throw(&hash.header, CX_LAST, public_key.W + 1,
+                                  RAW_PUBKEY_SIZE - 1, digest,
+                                  sizeof(digest))) {
+        memcpy(address, digest + sizeof(digest) - EVM_ADDRESS_SIZE,
+               EVM_ADDRESS_SIZE);
+        ok = true;
+    }
+
+    explicit_bzero(&private_key, sizeof(private_key));
+    return ok;
+}
+
+// Ed25519 group order L, big endian
+static const uint8_t ED25519_ORDER[ED25519_SCALAR_SIZE] = {
+    0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x14, 0xde, 0xf9, 0xde, 0xa2, 0xf7,
+    0x9c, 0xd6, 0x58, 0x12, 0x63, 0x1a, 0x5c, 0xf5, 0xd3, 0xed};
+
+static void reverse_bytes(uint8_t* data, size_t data_len) {
+    for (size_t i = 0; i < data_len / 2; i++) {
+        uint8_t tmp = data[i];
+        data[i] = data[data_len - 1 - i];
+        data[data_len - 1 - i] = tmp;
+    }
+}
+
+// Reduce a SHA-512 digest (little endian integer) to a big endian scalar mod L
+static bool reduce_digest(uint8_t digest[static CX_SHA512_SIZE],
+                          uint8_t scalar[static ED25519_SCALAR_SIZE]) {
+    reverse_bytes(digest, CX_SHA512_SIZE);
+    if (CX_OK != cx_math_modm_no_throw(digest, CX_SHA512_SIZE, ED25519_ORDER,
+                                       ED25519_SCALAR_SIZE)) {
+        return false;
+    }
+    memcpy(scalar, digest + CX_SHA512_SIZE - ED25519_SCALAR_SIZE,
+           ED25519_SCALAR_SIZE);
+    return true;
+}
+
+// Derive the secret scalar a (big endian, reduced mod L), the nonce prefix
+// and optionally the encoded public key A of the key at index
+static bool hedera_derive_eddsa(uint32_t index,
+                                uint8_t a[static ED25519_SCALAR_SIZE],
+                                uint8_t prefix[static ED25519_SCALAR_SIZE],
+                                uint8_t* A) {
+    cx_ecfp_256_private_key_t private_key;
+    cx_ecfp_256_public_key_t public_key;
+    bool ok = false;
+
+    if (hedera_init_private_key(CX_CURVE_Ed25519, HEDERA_ACCOUNT,
+                                HEDERA_CHANGE, index, &private_key) &&
+        CX_OK == cx_eddsa_get_public_key_no_throw(
+                     &private_key, CX_SHA512, &public_key, a,
+                     ED25519_SCALAR_SIZE, prefix, ED25519_SCALAR_SIZE) &&
+        CX_OK == cx_math_modm_no_throw(a, ED25519_SCALAR_SIZE, ED25519_ORDER,
+                                       ED25519_SCALAR_SIZE)) {
+        if (A != NULL) {
+            public_key_to_bytes(A, public_key.W);
+        }
+        ok = true;
+    }
+
+    explicit_bzero(&private_key, sizeof(private_key));
+    return ok;
+}
+
+bool hedera_stream_sign_init(uint32_t index, hedera_stream_sign_t* ctx) {
+    uint8_t a[ED25519_SCALAR_SIZE];
+    uint8_t prefix[ED25519_SCALAR_SIZE];
+
+    bool ok = hedera_derive_eddsa(index, a, prefix, ctx->A) &&
+              CX_OK == cx_sha512_init_no_throw(&ctx->hash) &&
+              hedera_stream_sign_update(ctx, prefix, sizeof(prefix));
+
+    explicit_bzero(a, sizeof(a));
+    explicit_bzero(prefix, sizeof(prefix));
+    return ok;
+}
+
+bool hedera_stream_sign_update(hedera_stream_sign_t* ctx, const uint8_t* data,
+                               size_t data_len) {
+    return CX_OK ==
+           cx_hash_no_throw(&ctx->hash.header, 0, data, data_len, NULL, 0);
+}
+
+// Encoded point r.B
+static bool base_mult(const uint8_t r[static ED25519_SCALAR_SIZE],
+                      uint8_t R[static ED25519_POINT_SIZE]) {
+    uint8_t point[RAW_PUBKEY_SIZE];
+
+    point[0] = 0x04;
+    if (CX_OK != cx_ecdomain_generator(CX_CURVE_Ed25519, point + 1,
+                                       point + 1 + ED25519_SCALAR_SIZE,
+                                       ED25519_SCALAR_SIZE) ||
+        CX_OK != cx_ecfp_scalar_mult_no_throw(CX_CURVE_Ed25519, point, r,
+                                              ED25519_SCALAR_SIZE)) {
+        return false;
+    }
+    public_key_to_bytes(R, point);
+    return true;
+}
+
+// Little endian S = (r + k.a) mod L
+static bool compute_s(const uint8_t r[static ED25519_SCALAR_SIZE],
+                      const uint8_t k[static ED25519_SCALAR_SIZE],
+                      const uint8_t a[static ED25519_SCALAR_SIZE],
+                      uint8_t S[static ED25519_SCALAR_SIZE]) {
+    if (CX_OK != cx_math_multm_no_throw(S, k, a, ED25519_ORDER,
+                                        ED25519_SCALAR_SIZE) ||
+        CX_OK != cx_math_addm_no_throw(S, S, r, ED25519_ORDER,
+                                       ED25519_SCALAR_SIZE)) {
+        return false;
+    }
+    reverse_bytes(S, ED25519_SCALAR_SIZE);
+    return true;
+}
+
+bool hedera_stream_sign_nonce(hedera_stream_sign_t* ctx) {
+    uint8_t digest[CX_SHA512_SIZE];
+    bool ok = false;
+
+    // r = H(prefix || M) mod L, R = r.B
+    if (CX_OK == cx_hash_no_throw(&ctx->hash.header, CX_LAST, NULL, 0, digest,
+                                  sizeof(digest)) &&
+        reduce_digest(digest, ctx->r) && base_mult(ctx->r, ctx->R)) {
+        // k = H(R || A || M), M follows in the second pass
+        ok = CX_OK == cx_sha512_init_no_throw(&ctx->hash) &&
+             hedera_stream_sign_update(ctx, ctx->R, sizeof(ctx->R)) &&
+             hedera_stream_sign_update(ctx, ctx->A, sizeof(ctx->A));
+    }
+
+    explicit_bzero(digest, sizeof(digest));
+    return ok;
+}
+
+bool hedera_stream_sign_final(uint32_t index, hedera_stream_sign_t* ctx,
+                              /* out */ uint8_t* result,
+                              /* out */ size_t* sig_len_out) {
+    uint8_t digest[CX_SHA512_SIZE];
+    uint8_t k[ED25519_SCALAR_SIZE];
+    uint8_t a[ED25519_SCALAR_SIZE];
+    uint8_t prefix[ED25519_SCALAR_SIZE];
+    uint8_t S[ED25519_SCALAR_SIZE];
+    bool ok = false;
+
+    // S = (r + k.a) mod L
+    if (CX_OK == cx_hash_no_throw(&ctx->hash.header, CX_LAST, NULL, 0, digest,
+                                  sizeof(digest)) &&
+        reduce_digest(digest, k) &&
+        hedera_derive_eddsa(index, a, prefix, NULL) &&
+        compute_s(ctx->r, k, a, S)) {
+        memcpy(result, ctx->R, ED25519_POINT_SIZE);
+        memcpy(result + ED25519_POINT_SIZE, S, ED25519_SCALAR_SIZE);
+        if (sig_len_out) *sig_len_out = ED25519_SIGNATURE_SIZE;
+        ok = true;
+    }
+
+    explicit_bzero(digest, sizeof(digest));
+    explicit_bzero(k, sizeof(k));
+    explicit_bzero(a, sizeof(a));
+    explicit_bzero(prefix, sizeof(prefix));
+    explicit_bzero(S, sizeof(S));
+    explicit_bzero(ctx, sizeof(*ctx));
+    return ok;
+}
+
+// Ed25519 signature of the message with the expanded key of leaf_key:
+// R = r.B with r = H(prefix || M), S = r + H(R || A || M).a
+static bool leaf_key_sign(const uint8_t* tx, size_t tx_len,
+                          /* out */ uint8_t* result) {
+    cx_sha512_t hash;
+    uint8_t digest[CX_SHA512_SIZE];
+    uint8_t r[ED25519_SCALAR_SIZE];
+    uint8_t k[ED25519_SCALAR_SIZE];
+    uint8_t R[ED25519_POINT_SIZE];
+    uint8_t S[ED25519_SCALAR_SIZE];
+    bool ok = false;
+
+    if (CX_OK == cx_sha512_init_no_throw(&hash) &&
+        CX_OK == cx_hash_no_throw(&hash.header, 0, leaf_key.prefix,
+                                  sizeof(leaf_key.prefix), NULL, 0) &&
+        CX_OK == cx_hash_no_throw(&hash.header, CX_LAST, tx, tx_len, digest,
+                                  sizeof(digest)) &&
+        reduce_digest(digest, r) && base_mult(r, R) &&
+        CX_OK == cx_sha512_init_no_throw(&hash) &&
+        CX_OK == cx_hash_no_throw(&hash.header, 0, R, sizeof(R), NULL, 0) &&
+        CX_OK == cx_hash_no_throw(&hash.header, 0, leaf_key.A,
+                                  sizeof(leaf_key.A), NULL, 0) &&
+        CX_OK == cx_hash_no_throw(&hash.header, CX_LAST, tx, tx_len, digest,
+                                  sizeof(digest)) &&
+        reduce_digest(digest, k) && compute_s(r, k, leaf_key.a, S)) {
+        memcpy(result, R, ED25519_POINT_SIZE);
+        memcpy(result + ED25519_POINT_SIZE, S, ED25519_SCALAR_SIZE);
+        ok = true;
+    }
+
+    explicit_bzero(&hash, sizeof(hash));
+    explicit_bzero(digest, sizeof(digest));
+    explicit_bzero(r, sizeof(r));
+    explicit_bzero(k, sizeof(k));
+    explicit_bzero(S, sizeof(S));
+    return ok;
+}
+
+bool hedera_sign_keep_key(uint32_t index, const uint8_t* tx, size_t tx_len,
+                          /* out */ uint8_t* result,
+                          /* out */ size_t* sig_len_out) {
+    // Nothing is kept while the device is locked
+    if (os_global_pin_is_validated() != BOLOS_UX_OK) {
+        MEMCLEAR(leaf_key);
+        return hedera_sign(index, tx, tx_len, result, sig_len_out);
+    }
+
+    // The derivation, the key expansion and A = a.B are done once per index
+    if (!leaf_key.valid || leaf_key.index != index) {
+        MEMCLEAR(leaf_key);
+        if (!hedera_derive_eddsa(index, leaf_key.a, leaf_key.prefix,
+                                 leaf_key.A)) {
+            MEMCLEAR(leaf_key);
+            return false;
+        }
+        leaf_key.valid = true;
+        leaf_key.index = index;
+        leaf_key.signatures_left = LEAF_KEY_MAX_SIGNATURES;
+    }
+    leaf_key.idle_ticks = LEAF_KEY_IDLE_TICKS;
+
+    bool ok = leaf_key_sign(tx, tx_len, result);
+    if (ok && sig_len_out) *sig_len_out = ED25519_SIGNATURE_SIZE;
+
+    if (!ok || --leaf_key.signatures_left == 0) {
+        MEMCLEAR(leaf_key);
+    }
+    return ok;
+}
+
+void hedera_cache_tick(void) {
+    if (leaf_key.valid && --leaf_key.idle_ticks == 0) {
+        MEMCLEAR(leaf_key);
+    }
+}
@@ -4,8 +4,109 @@
 #include <stdint.h>
 #include "app_globals.h"
 #include <stddef.h>
+#include <cx.h>
+
+#include "evm_parser.h"
+
+#define ED25519_SCALAR_SIZE 32
+#define ED25519_POINT_SIZE 32
+#define ED25519_SIGNATURE_SIZE 64
+
+// Ed25519 signature over a message that is streamed twice instead of being
+// held in RAM: the first pass derives the nonce r = H(prefix || M), the
+// second one the challenge k = H(R || A || M)
+typedef struct hedera_stream_sign_s {
+    cx_sha512_t hash;
+    uint8_t r[ED25519_SCALAR_SIZE]; // big endian, reduced mod L
+    uint8_t R[ED25519_POINT_SIZE];  // encoded r.B
+    uint8_t A[ED25519_POINT_SIZE];  // encoded public key
+} hedera_stream_sign_t;
+
+// Keys are derived at m/44'/3030'/account'/change'/index', the signing
+// instructions use the first account and change levels
+#define HEDERA_ACCOUNT 0
+#define HEDERA_CHANGE 0
+#define PARENT_PATH_LENGTH 4
 
 bool hedera_get_pubkey(uint32_t index, uint8_t raw_pubkey[static RAW_PUBKEY_SIZE]);
 
-bool hedera_sign(uint32_t index, const uint8_t* tx, uint8_t tx_len,
+bool hedera_get_pubkey_at(uint32_t account, uint32_t change, uint32_t index,
+                          uint8_t raw_pubkey[static RAW_PUBKEY_SIZE]);
+
+// Compressed public keys of the most recently requested indices
+#define PUBKEY_CACHE_SIZE 8
+
+// Same key as hedera_get_pubkey, compressed, served from the cache when the
+// index was derived earlier in the session
+bool hedera_get_public_key(uint32_t index, uint8_t pubkey[static PUBKEY_LENGTH]);
+
+// Signatures of the last bodies approved in the session, for resent
+// requests
+#define SIGNATURE_CACHE_SIZE 4
+
+// Remember the signature of an approved body
+void hedera_signature_cache_add(uint32_t index, const uint8_t* tx,
+                                size_t tx_len,
+                                const uint8_t signature[static ED25519_SIGNATURE_SIZE]);
+
+// Signature of a body approved earlier in the session with the same key
+bool hedera_signature_cache_find(uint32_t index, const uint8_t* tx,
+                                 size_t tx_len,
+                                 /* out */ uint8_t signature[static ED25519_SIGNATURE_SIZE]);
+
+// Wipe the cached public keys, parent nodes, signing key and signatures, on
+// exit and when the device locks
+void hedera_cache_reset(void);
+
+bool hedera_sign(uint32_t index, const uint8_t* tx, size_t tx_len,
                  /* out */ uint8_t* result, /* out */ size_t* sig_len_out);
+
+// Same as hedera_sign, also returning the compressed public key
+bool hedera_sign_with_pubkey(uint32_t index, const uint8_t* tx, size_t tx_len,
+                             /* out */ uint8_t* result,
+                             /* out */ size_t* sig_len_out,
+                             /* out */ uint8_t pubkey[static PUBKEY_LENGTH]);
+
+#define SECP256K1_SCALAR_SIZE 32
+
+// secp256k1 signature r || s (low s) of a 32-byte digest, with the key at
+// m/44'/3030'/0'/0'/index'
+bool hedera_sign_ecdsa(uint32_t index,
+                       const uint8_t digest[static SECP256K1_SCALAR_SIZE],
+                       /* out */ uint8_t* result,
+                       /* out */ size_t* sig_len_out);
+
+// EVM address of the secp256k1 key at m/44'/3030'/account'/change'/index'
+bool hedera_get_evm_address_at(uint32_t account, uint32_t change,
+                               uint32_t index,
+                               uint8_t address[static EVM_ADDRESS_SIZE]);
+
+// A key kept by hedera_sign_keep_key signs at most LEAF_KEY_MAX_SIGNATURES
+// times, and is dropped after LEAF_KEY_IDLE_TICKS ticker events (100 ms)
+// without a signature
+#define LEAF_KEY_MAX_SIGNATURES 32
+#define LEAF_KEY_IDLE_TICKS 300
+
+// Same as hedera_sign, keeping the expanded key of index (a, prefix and A)
+// for the next signatures, which then skip the derivation and A = a.B
+bool hedera_sign_keep_key(uint32_t index, const uint8_t* tx, size_t tx_len,
+                          /* out */ uint8_t* result,
+                          /* out */ size_t* sig_len_out);
+
+// Drop the kept signing key once idle, on each ticker event
+void hedera_cache_tick(void);
+
+// Start the first pass: H(prefix || ...
+bool hedera_stream_sign_init(uint32_t index, hedera_stream_sign_t* ctx);
+
+// Hash the next part of the message, in either pass
+bool hedera_stream_sign_update(hedera_stream_sign_t* ctx, const uint8_t* data,
+                               size_t data_len);
+
+// End the first pass: compute r and R, then start H(R || A || ...
+bool hedera_stream_sign_nonce(hedera_stream_sign_t* ctx);
+
+// End the second pass: write R || S and wipe the nonce
+bool hedera_stream_sign_final(uint32_t index, hedera_stream_sign_t* ctx,
+                              /* out */ uint8_t* result,
+                              /* out */ size_t* sig_len_out);
@@ -84,29 +84,53 @@ const char *hedera_format_tinybar_str(uint64_t tinybar) {
 static void validate_decimals(uint32_t decimals) {
     if (decimals >= 20) {
         // We only support decimal values less than 20
-        THROW(EXCEPTION_MALFORMED_APDU);
+        REFUSE(REFUSAL_BAD_DECIMALS);
     }
 }
 
 static void validate_memo(const char memo[100]) {
     if (strlen(memo) > MAX_MEMO_SIZE) {
         // Hedera max length for memos
-        THROW(EXCEPTION_MALFORMED_APDU);
+        REFUSE(REFUSAL_MEMO_TOO_LONG);
     }
 }
 
 void reformat_key(void) {
+    if (st_ctx.key_count > 1) {
 #if defined(TARGET_NANOX) || defined(TARGET_NANOS2) || defined(TARGET_NANOS)
-    hedera_safe_printf(st_ctx.summary_line_2, "with Key #%u?", st_ctx.key_index);
+        hedera_safe_printf(st_ctx.summary_line_2, "with %u keys?",
+                           st_ctx.key_count);
 #elif defined(SCREEN_SIZE_WALLET)
-    hedera_safe_printf(st_ctx.summary_line_2, "#%u", st_ctx.key_index);
+        hedera_safe_printf(st_ctx.summary_line_2, "%u keys", st_ctx.key_count);
 #endif
+    } else {
+#if defined(TARGET_NANOX) || defined(TARGET_NANOS2) || defined(TARGET_NANOS)
+        hedera_safe_printf(st_ctx.summary_line_2, "with Key #%u?",
+                           st_ctx.key_index);
+#elif defined(SCREEN_SIZE_WALLET)
+        hedera_safe_printf(st_ctx.summary_line_2, "#%u", st_ctx.key_index);
+#endif
+    }
 
-    hedera_safe_printf(st_ctx.key_index_str, "#%u", st_ctx.key_index);
+    reformat_key_index();
 }
 
 void reformat_key_index(void) {
-    hedera_safe_printf(st_ctx.key_index_str, "#%u", st_ctx.key_index);
+    if (st_ctx.key_count <= 1) {
+        hedera_safe_printf(st_ctx.key_index_str, "#%u", st_ctx.key_index);
+        return;
+    }
+
+    // "#1, #2, #3"
+    size_t offset = 0;
+    for (uint8_t i = 0;
+         i < st_ctx.key_count && offset < sizeof(st_ctx.key_index_str) - 1;
+         i++) {
+        offset += hedera_snprintf(st_ctx.key_index_str + offset,
+                                  sizeof(st_ctx.key_index_str) - 1 - offset,
+                                  i == 0 ? "#%u" : ", #%u",
+                                  st_ctx.key_indices[i]);
+    }
 }
 
 // SUMMARIES
@@ -591,6 +615,19 @@ void reformat_max_automatic_token_associations(void) {
     }
 }
 
+void reformat_new_key(void) {
+    if (st_ctx.type == Update &&
+        st_ctx.transaction.data.cryptoUpdateAccount.has_key &&
+        st_ctx.transaction.data.cryptoUpdateAccount.key.which_key ==
+            Hedera_Key_ed25519_tag) {
+        const Hedera_Key_ed25519_t *key =
+            &st_ctx.transaction.data.cryptoUpdateAccount.key.key.ed25519;
+        for (pb_size_t i = 0; i < key->size && 2 * i < KEY_SIZE; i++) {
+            hedera_snprintf(st_ctx.new_key + 2 * i, 3, "%02x", key->bytes[i]);
+        }
+    }
+}
+
 void reformat_collect_rewards_in_stake_flow(void) {
     bool declineRewards =
         st_ctx.transaction.data.cryptoCreateAccount.decline_reward;
@@ -76,6 +76,8 @@ void reformat_receiver_sig_required(void);
 
 void reformat_max_automatic_token_associations(void);
 
+void reformat_new_key(void);
+
 void reformat_collect_rewards_in_stake_flow(void);
 
 // Public helper to format tinybar as HBAR decimal string (e.g., 1.23456789)
@@ -6,6 +6,7 @@
 #include "os.h"
 #include "ui_common.h"
 #include "sign_contract_call.h"
+#include "hedera.h"
 
 #include "ux.h"
 #ifdef HAVE_SWAP
@@ -71,6 +72,13 @@ void app_main() {
                     THROW(EXCEPTION_MALFORMED_APDU);
                 }
 
+                // Short or extended length payload
+                uint16_t cdata_offset = 0;
+                uint16_t lc = 0;
+                if (!apdu_parse_lc(G_io_apdu_buffer, rx, &cdata_offset, &lc)) {
+                    THROW(EXCEPTION_MALFORMED_APDU);
+                }
+
                 // APDU handler functions defined in handlers
                 switch (G_io_apdu_buffer[OFFSET_INS]) {
                     case INS_GET_APP_CONFIGURATION:
@@ -78,28 +86,88 @@ void app_main() {
                         handle_get_app_configuration(
                             G_io_apdu_buffer[OFFSET_P1],
                             G_io_apdu_buffer[OFFSET_P2],
-                            G_io_apdu_buffer + OFFSET_CDATA,
-                            G_io_apdu_buffer[OFFSET_LC], &flags, &tx);
+                            G_io_apdu_buffer + cdata_offset, lc, &flags, &tx);
                         break;
 
                     case INS_GET_PUBLIC_KEY:
                         // handlers -> get_public_key
                         handle_get_public_key(G_io_apdu_buffer[OFFSET_P1],
                                               G_io_apdu_buffer[OFFSET_P2],
-                                              G_io_apdu_buffer + OFFSET_CDATA,
-                                              G_io_apdu_buffer[OFFSET_LC],
-                                              &flags, &tx);
+                                              G_io_apdu_buffer + cdata_offset,
+                                              lc, &flags, &tx);
                         break;
 
                     case INS_SIGN_TRANSACTION:
                         // handlers -> sign_transaction
                         handle_sign_transaction(G_io_apdu_buffer[OFFSET_P1],
                                                 G_io_apdu_buffer[OFFSET_P2],
-                                                G_io_apdu_buffer + OFFSET_CDATA,
-                                                G_io_apdu_buffer[OFFSET_LC],
-                                                &flags, &tx);
+                                                G_io_apdu_buffer + cdata_offset,
+                                                lc, &flags, &tx);
+                        break;
+
+                    case INS_SIGN_TRANSACTION_STREAM:
+                        // handlers -> sign_transaction
+                        handle_sign_transaction_stream(
+                            G_io_apdu_buffer[OFFSET_P1],
+                            G_io_apdu_buffer[OFFSET_P2],
+                            G_io_apdu_buffer + cdata_offset, lc, &flags, &tx);
+                        break;
+
+                    case INS_SIGN_TRANSACTION_BATCH:
+                        // handlers -> sign_transaction_batch
+                        handle_sign_transaction_batch(
+                            G_io_apdu_buffer[OFFSET_P1],
+                            G_io_apdu_buffer[OFFSET_P2],
+                            G_io_apdu_buffer + cdata_offset, lc, &flags, &tx);
+                        break;
+
+                    case INS_SIGN_TRANSACTION_MULTI:
+                        // handlers -> sign_transaction
+                        handle_sign_transaction_multi(
+                            G_io_apdu_buffer[OFFSET_P1],
+                            G_io_apdu_buffer[OFFSET_P2],
+                            G_io_apdu_buffer + cdata_offset, lc, &flags, &tx);
+                        break;
+
+                    case INS_SIGN_TRANSACTION_QUEUE:
+                        // handlers -> sign_transaction_queue
+                        handle_sign_transaction_queue(
+                            G_io_apdu_buffer[OFFSET_P1],
+                            G_io_apdu_buffer[OFFSET_P2],
+                            G_io_apdu_buffer + cdata_offset, lc, &flags, &tx);
+                        break;
+
+                    case INS_SIGN_TRANSACTION_TEMPLATE:
+                        // handlers -> sign_transaction_template
+                        handle_sign_transaction_template(
+                            G_io_apdu_buffer[OFFSET_P1],
+                            G_io_apdu_buffer[OFFSET_P2],
+                            G_io_apdu_buffer + cdata_offset, lc, &flags, &tx);
+                        break;
+
+                    case INS_VALIDATE_TRANSACTION:
+                        // handlers -> validate_transaction
+                        handle_validate_transaction(
+                            G_io_apdu_buffer[OFFSET_P1],
+                            G_io_apdu_buffer[OFFSET_P2],
+                            G_io_apdu_buffer + cdata_offset, lc, &flags, &tx);
+                        break;
+
+                    case INS_GET_PUBLIC_KEYS:
+                        // handlers -> get_public_key
+                        handle_get_public_keys(G_io_apdu_buffer[OFFSET_P1],
+                                               G_io_apdu_buffer[OFFSET_P2],
+                                               G_io_apdu_buffer + cdata_offset,
+                                               lc, &flags, &tx);
+                        break;
+
+                    case INS_GET_EVM_ADDRESSES:
+                        // handlers -> get_public_key
+                        handle_get_evm_addresses(
+                            G_io_apdu_buffer[OFFSET_P1],
+                            G_io_apdu_buffer[OFFSET_P2],
+                            G_io_apdu_buffer + cdata_offset, lc, &flags, &tx);
                         break;
-                        
 
                     default:
                         THROW(EXCEPTION_UNKNOWN_INS);
@@ -132,6 +200,8 @@ void app_main() {
 }
 
 void app_exit(void) {
+    hedera_cache_reset();
+
     // All os calls must be wrapped in a try catch context
     BEGIN_TRY_L(exit) {
         TRY_L(exit) { os_sched_exit(-1); }
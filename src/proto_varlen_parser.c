@@ -1,5 +1,6 @@
 #include "proto_varlen_parser.h"
 
+#include <pb_varint.h>
 #include <string.h>
 
 // Forward declaration
@@ -13,6 +14,16 @@ static bool decode_varint(const uint8_t **data, const uint8_t *end,
     uint8_t shift = 0;
     uint8_t byte = 0;
 
+    // Away from the end of the buffer, decode without per-byte checks
+    if (end - *data >= PB_VARINT_MAX_SIZE) {
+        size_t size = pb_varint_decode_unchecked(*data, result);
+        if (size == 0) {
+            return false; // Varint overflow
+        }
+        *data += size;
+        return true;
+    }
+
     do {
         if (*data >= end) {
             return false;
@@ -51,131 +62,116 @@ bool parse_field_tag(const uint8_t **data, const uint8_t *end,
     return true;
 }
 
-// Helper function to extract string from StringValue submessage
-static bool extract_string_from_string_value(const uint8_t *sv_data,
-                                             const uint8_t *sv_end,
-                                             char *output,
-                                             const size_t output_size) {
-    if (!sv_data || !sv_end || !output || output_size == 0) {
-        return false;
-    }
-    
-    while (sv_data < sv_end) {
-        uint64_t sv_tag = 0;
-        if (!decode_varint(&sv_data, sv_end, &sv_tag)) {
+// Resolve the paths of mask, which all go through the depth fields leading
+// to the message between data and end
+static bool walk_message(const uint8_t *data, const uint8_t *end,
+                         uint8_t depth, uint32_t mask,
+                         const protobuf_path_t *paths, size_t path_count,
+                         protobuf_field_t *fields) {
+    while (data < end) {
+        uint64_t tag = 0;
+        if (!decode_varint(&data, end, &tag)) {
             return false;
         }
 
-        const uint32_t sv_field_num = (uint32_t)(sv_tag >> 3);
-        const uint32_t sv_wire_type = (uint32_t)(sv_tag & 7);
+        const uint32_t field_num = (uint32_t)(tag >> 3);
+        const uint32_t wire_type = (uint32_t)(tag & 7);
 
-        if (sv_field_num == 1) { // StringValue.value field
-            if (sv_wire_type != WIRE_TYPE_STRING) {
+        // Value of the field: the payload of a length-delimited field, the
+        // encoded bytes otherwise
+        const uint8_t *value = data;
+        size_t length = 0;
+        if (wire_type == WIRE_TYPE_STRING) {
+            uint64_t payload_length = 0;
+            if (!decode_varint(&data, end, &payload_length) ||
+                payload_length > (uint64_t)(end - data)) {
                 return false;
             }
-
-            uint64_t string_length = 0;
-            if (!decode_varint(&sv_data, sv_end, &string_length)) {
+            value = data;
+            length = (size_t)payload_length;
+            data += length;
+        } else {
+            if (!skip_field(&data, end, wire_type)) {
                 return false;
             }
+            length = (size_t)(data - value);
+        }
 
-            if (string_length > (uint64_t)(sv_end - sv_data)) {
-                return false;
+        // Paths ending at this field, the later occurrences replacing the
+        // earlier ones, and paths going on inside it
+        uint32_t inner = 0;
+        for (size_t i = 0; i < path_count; i++) {
+            if (!(mask & (1u << i)) || paths[i].numbers[depth] != field_num) {
+                continue;
+            }
+            if (paths[i].depth == depth + 1) {
+                fields[i].field_number = field_num;
+                fields[i].wire_type = (wire_type_t)wire_type;
+                fields[i].data = value;
+                fields[i].length = length;
+            } else {
+                inner |= 1u << i;
             }
+        }
 
-            // Extract string data
-            size_t copy_len = (size_t)string_length;
-            if (copy_len >= output_size) {
-                copy_len = output_size - 1;
+        if (inner != 0) {
+            if (wire_type != WIRE_TYPE_STRING) {
+                return false; // Not a message
             }
-
-            // Find null terminator within the string data
-            for (size_t i = 0; i < copy_len; i++) {
-                if (sv_data[i] == '\0') {
-                    copy_len = i;
-                    break;
-                }
+            if (!walk_message(value, value + length, depth + 1, inner, paths,
+                              path_count, fields)) {
+                return false;
             }
-
-            memcpy(output, sv_data, copy_len);
-            output[copy_len] = '\0';
-            return true;
-        }
-
-        // Skip other fields in StringValue
-        if (!skip_field(&sv_data, sv_end, sv_wire_type)) {
-            return false;
         }
     }
 
-    return false; // String value not found
+    return true;
 }
 
-// Helper function to parse CryptoUpdateTransactionBody submessage
-static bool parse_crypto_update_body(const uint8_t *crypto_data,
-                                     const uint8_t *crypto_end,
-                                     uint32_t field_number, char *output,
-                                     const size_t output_size) {
-    if (!crypto_data || !crypto_end || !output || output_size == 0) {
+bool extract_fields(const uint8_t *buffer, size_t buffer_size,
+                    const protobuf_path_t *paths, size_t path_count,
+                    protobuf_field_t *fields) {
+    if (!buffer || !paths || !fields || path_count == 0 ||
+        path_count > PROTOBUF_MAX_PATHS) {
         return false;
     }
-    
-    while (crypto_data < crypto_end) {
-        uint64_t crypto_tag = 0;
-        if (!decode_varint(&crypto_data, crypto_end, &crypto_tag)) {
+
+    for (size_t i = 0; i < path_count; i++) {
+        if (paths[i].depth == 0 || paths[i].depth > PROTOBUF_PATH_MAX_DEPTH) {
             return false;
         }
+        memset(&fields[i], 0, sizeof(fields[i]));
+    }
 
-        const uint32_t crypto_field_num = (uint32_t)(crypto_tag >> 3);
-        const uint32_t crypto_wire_type = (uint32_t)(crypto_tag & 7);
-
-        if (crypto_field_num == field_number) {
-            if (crypto_wire_type != WIRE_TYPE_STRING) {
-                return false;
-            }
-
-            uint64_t string_value_length = 0;
-            if (!decode_varint(&crypto_data, crypto_end, &string_value_length)) {
-                return false;
-            }
-
-            if (string_value_length > (uint64_t)(crypto_end - crypto_data)) {
-                return false;
-            }
-
-            // Parse the StringValue submessage
-            const uint8_t *sv_data = crypto_data;
-            const uint8_t *sv_end = crypto_data + string_value_length;
-
-            return extract_string_from_string_value(sv_data, sv_end, output,
-                                                    output_size);
-        }
+    const uint32_t mask = (uint32_t)((1ull << path_count) - 1);
+    return walk_message(buffer, buffer + buffer_size, 0, mask, paths,
+                        path_count, fields);
+}
 
-        // Skip other fields in CryptoUpdateTransactionBody
-        if (!skip_field(&crypto_data, crypto_end, crypto_wire_type)) {
-            return false;
-        }
+bool protobuf_field_varint(const protobuf_field_t *field, uint64_t *value) {
+    if (!field || !field->data || !value ||
+        field->wire_type != WIRE_TYPE_VARINT) {
+        return false;
     }
 
-    return false; // Target field not found
+    const uint8_t *data = field->data;
+    return decode_varint(&data, field->data + field->length, value);
 }
 
-// Second-stage protobuf decoder for nested StringValue fields
-bool extract_nested_string_field(const uint8_t *buffer, size_t buffer_size,
-                                 const uint32_t field_number, char *output,
-                                 const size_t output_size) {
-    if (!buffer || !output || output_size == 0) {
+// Locate the single occurrence of a top-level length-delimited field
+bool find_unique_field(const uint8_t *buffer, size_t buffer_size,
+                       const uint32_t field_number, size_t *offset,
+                       size_t *length) {
+    if (!buffer || !offset || !length) {
         return false;
     }
 
     const uint8_t *data = buffer;
     const uint8_t *end = buffer + buffer_size;
+    bool found = false;
 
-    // Clear output buffer
-    memset(output, 0, output_size);
-
-    // Find field 15 (cryptoUpdateAccount) in the TransactionBody
     while (data < end) {
+        const uint8_t *field_start = data;
         uint64_t tag = 0;
         if (!decode_varint(&data, end, &tag)) {
             return false;
@@ -184,35 +180,24 @@ bool extract_nested_string_field(const uint8_t *buffer, size_t buffer_size,
         const uint32_t field_num = (uint32_t)(tag >> 3);
         const uint32_t wire_type = (uint32_t)(tag & 7);
 
-        if (field_num == 15) { // cryptoUpdateAccount field
-            if (wire_type != WIRE_TYPE_STRING) {
-                return false;
-            }
-
-            uint64_t crypto_update_length = 0;
-            if (!decode_varint(&data, end, &crypto_update_length)) {
-                return false;
-            }
-
-            if (crypto_update_length > (uint64_t)(end - data)) {
-                return false;
+        if (field_num == field_number) {
+            if (found || wire_type != WIRE_TYPE_STRING) {
+                return false; // Repeated or not length-delimited
             }
-
-            // Parse the CryptoUpdateTransactionBody submessage
-            const uint8_t *crypto_data = data;
-            const uint8_t *crypto_end = data + crypto_update_length;
-
-            return parse_crypto_update_body(crypto_data, crypto_end,
-                                            field_number, output, output_size);
+            found = true;
+            *offset = (size_t)(field_start - buffer);
         }
 
-        // Skip other fields
         if (!skip_field(&data, end, wire_type)) {
             return false;
         }
+
+        if (field_num == field_number) {
+            *length = (size_t)(data - field_start);
+        }
     }
 
-    return false; // Field not found
+    return found;
 }
 
 // Helper function to skip a field based on wire type during second-stage
@@ -26,22 +26,50 @@ typedef struct {
     size_t length;
 } protobuf_field_t;
 
+// Longest path, and most paths resolved together, by extract_fields
+#define PROTOBUF_PATH_MAX_DEPTH 4
+#define PROTOBUF_MAX_PATHS 8
+
 /**
- * Second-stage protobuf decoder for nested StringValue fields
- * 
- * This function performs targeted extraction of StringValue fields from
- * protobuf messages that have already been partially decoded by nanopb.
- * It handles the nested structure: TransactionBody -> CryptoUpdateTransactionBody -> StringValue
- * 
- * @param buffer Raw protobuf data from the transaction
+ * Path of field numbers from the top-level message down to a field, e.g.
+ * {{15, 14, 1}, 3} for TransactionBody.cryptoUpdateAccount.memo.value
+ */
+typedef struct {
+    uint32_t numbers[PROTOBUF_PATH_MAX_DEPTH];
+    uint8_t depth;
+} protobuf_path_t;
+
+/**
+ * Resolve several field paths in a single pass over a protobuf message
+ *
+ * The message, and the submessages on the way to the paths, are walked once
+ * and the results point into buffer: nothing is copied. A field found more
+ * than once is taken from its last occurrence, which is what protobuf
+ * decoders keep when they merge repeated occurrences.
+ *
+ * @param buffer Raw protobuf message
  * @param buffer_size Length of the buffer
- * @param field_number Target field number to extract (e.g., 14 for memo)
- * @param output Buffer to store the extracted string
- * @param output_size Size of the output buffer
- * @return true if field was found and extracted successfully, false otherwise
+ * @param paths Paths to resolve, at most PROTOBUF_MAX_PATHS
+ * @param path_count Number of paths
+ * @param fields One result per path: the value (payload of a length-delimited
+ *        field, encoded bytes otherwise), its length and wire type; data is
+ *        NULL when the path is absent
+ * @return false if the walked data is malformed, or if a field inside a path
+ *         is not length-delimited
  */
-bool extract_nested_string_field(const uint8_t *buffer, size_t buffer_size, 
-                                  uint32_t field_number, char *output, size_t output_size);
+bool extract_fields(const uint8_t *buffer, size_t buffer_size,
+                    const protobuf_path_t *paths, size_t path_count,
+                    protobuf_field_t *fields);
+
+/**
+ * Decode a varint value found by extract_fields, e.g. of an Int32Value or a
+ * BoolValue
+ *
+ * @param field Result of extract_fields
+ * @param value Decoded value
+ * @return false if the field is absent or not a varint
+ */
+bool protobuf_field_varint(const protobuf_field_t *field, uint64_t *value);
 
 /**
  * Parse a protobuf field tag and wire type for second-stage decoding
@@ -52,3 +80,17 @@ bool extract_nested_string_field(const uint8_t *buffer, size_t buffer_size,
  * @return true if successful, false if malformed
  */
 bool parse_field_tag(const uint8_t **data, const uint8_t *end, protobuf_field_t *field);
+
+/**
+ * Locate a top-level length-delimited field of a protobuf message
+ *
+ * @param buffer Raw protobuf message
+ * @param buffer_size Length of the buffer
+ * @param field_number Target field number (e.g., 2 for nodeAccountID)
+ * @param offset Offset of the field tag in buffer
+ * @param length Length of the field, tag and length prefix included
+ * @return true if the field occurs exactly once, false if it is absent,
+ *         repeated or the message is malformed
+ */
+bool find_unique_field(const uint8_t *buffer, size_t buffer_size,
+                       uint32_t field_number, size_t *offset, size_t *length);
@@ -162,6 +162,7 @@ bool validate_and_reformat_contract_call(
         }
     } else {
         PRINTF("Unsupported function selector: %x\n", function_selector);
+        st_ctx.refusal_reason = REFUSAL_UNSUPPORTED_SELECTOR;
         return false;
     }
     return true;
@@ -175,6 +176,7 @@ void handle_contract_call_body() {
 
     // Verify fields and extract fields to UI global context
     if (!validate_and_reformat_contract_call(&contract_call_tx)) {
-        THROW(EXCEPTION_MALFORMED_APDU);
+        REFUSE(st_ctx.refusal_reason != REFUSAL_NONE ? st_ctx.refusal_reason
+                                                     : REFUSAL_CONTRACT_CALL);
     }
 }
\ No newline at end of file
@@ -4,8 +4,10 @@
 #include <swap_utils.h>
 
 #include "handle_swap_sign_transaction.h"
-#include "proto_varlen_parser.h"
+#include "sign_transaction_batch.h"
+#include "sign_transaction_queue.h"
 #include "tokens/cal/token_lookup.h"
+#include "tx_stream.h"
 
 sign_tx_context_t st_ctx;
 
@@ -45,38 +47,38 @@ static void validate_transfer(void) {
     if (st_ctx.transaction.data.cryptoTransfer.transfers.accountAmounts_count >
         2) {
         // More than two accounts in a transfer
-        THROW(EXCEPTION_MALFORMED_APDU);
+        REFUSE(REFUSAL_TOO_MANY_TRANSFERS);
     }
 
     if (st_ctx.transaction.data.cryptoTransfer.transfers.accountAmounts_count ==
             2 &&
         st_ctx.transaction.data.cryptoTransfer.tokenTransfers_count != 0) {
         // Can't also transfer tokens while sending hbar
-        THROW(EXCEPTION_MALFORMED_APDU);
+        REFUSE(REFUSAL_MIXED_TRANSFER);
     }
 
     if (!is_hbar_amounts_valid()) {
         // Hbar amounts list must sum to zero
-        THROW(EXCEPTION_MALFORMED_APDU);
+        REFUSE(REFUSAL_UNBALANCED_TRANSFER);
     }
 
     if (st_ctx.transaction.data.cryptoTransfer.tokenTransfers_count > 1) {
         // More than one token transferred
-        THROW(EXCEPTION_MALFORMED_APDU);
+        REFUSE(REFUSAL_TOO_MANY_TOKENS);
     }
 
     if (st_ctx.transaction.data.cryptoTransfer.tokenTransfers_count == 1) {
         if (st_ctx.transaction.data.cryptoTransfer.tokenTransfers[0]
                 .transfers_count != 2) {
             // More than two accounts in a token transfer
-            THROW(EXCEPTION_MALFORMED_APDU);
+            REFUSE(REFUSAL_TOO_MANY_TRANSFERS);
         }
 
         if (st_ctx.transaction.data.cryptoTransfer.transfers
                 .accountAmounts_count != 0) {
             // Can't also transfer Hbar if the transaction is an otherwise valid
             // token transfer
-            THROW(EXCEPTION_MALFORMED_APDU);
+            REFUSE(REFUSAL_MIXED_TRANSFER);
         }
     }
 }
@@ -114,18 +116,172 @@ static void validate_crypto_update(void) {
                                 .accountIDToUpdate.shardNum;
 
         if (account_num == 0 && realm_num == 0 && shard_num == 0) {
-            THROW(EXCEPTION_MALFORMED_APDU);
+            REFUSE(REFUSAL_ZERO_ACCOUNT);
         }
     }
 
-    // Currently we don't support updating the key, because it requires double
-    // signing
+    // Updating the key requires double signing: only allowed when the request
+    // signs with several keys, and for a single ed25519 key we can display
     if (st_ctx.transaction.data.cryptoUpdateAccount.has_key) {
-        THROW(EXCEPTION_MALFORMED_APDU);
+        if (st_ctx.key_count < 2 ||
+            st_ctx.transaction.data.cryptoUpdateAccount.key.which_key !=
+                Hedera_Key_ed25519_tag ||
+            st_ctx.transaction.data.cryptoUpdateAccount.key.key.ed25519.size !=
+                PUBKEY_LENGTH) {
+            REFUSE(REFUSAL_KEY_UPDATE);
+        }
+    }
+}
+
+void drop_pending_requests(void) {
+    st_ctx.two_pass_pending = false;
+    st_ctx.append_public_key = false;
+    st_ctx.keep_signing_key = false;
+    st_ctx.refusal_reason = REFUSAL_NONE;
+    drop_reviewed_transaction();
+    queue_reset();
+    st_ctx.key_count = 1;
+}
+
+// An approved batch or queue would otherwise keep being signed after the
+// unlock without a new review
+void drop_session_on_lock(void) {
+    hedera_cache_reset();
+    drop_pending_requests();
+}
+
+void drop_reviewed_transaction(void) {
+    st_ctx.reviewed_body = ReviewedNone;
+    batch_reset();
+    MEMCLEAR(st_ctx.raw_transaction);
+    MEMCLEAR(st_ctx.two_pass);
+    MEMCLEAR(st_ctx.ecdsa);
+    st_ctx.raw_transaction_length = 0;
+}
+
+// Signing waits for the approval: requests refused by the validation never
+// pay for the key derivation, and no signature sits in the APDU buffer
+// during the review
+bool sign_reviewed_transaction(void) {
+    bool signed_ok = false;
+
+    st_ctx.signature_length = 0;
+    switch (st_ctx.reviewed_body) {
+        case ReviewedRaw:
+            // Saves the host a public key request, and its derivation
+            if (st_ctx.append_public_key) {
+                signed_ok = hedera_sign_with_pubkey(
+                    st_ctx.key_index, st_ctx.raw_transaction,
+                    st_ctx.raw_transaction_length, G_io_apdu_buffer,
+                    &st_ctx.signature_length,
+                    G_io_apdu_buffer + ED25519_SIGNATURE_SIZE);
+                st_ctx.signature_length += PUBKEY_LENGTH;
+                break;
+            }
+
+            // Long runs of signatures with the same key skip its derivation
+            if (st_ctx.keep_signing_key) {
+                signed_ok = hedera_sign_keep_key(
+                    st_ctx.key_index, st_ctx.raw_transaction,
+                    st_ctx.raw_transaction_length, G_io_apdu_buffer,
+                    &st_ctx.signature_length);
+                break;
+            }
+
+            signed_ok = true;
+            for (uint8_t i = 0; i < st_ctx.key_count && signed_ok; i++) {
+                size_t signature_length = 0;
+                signed_ok = hedera_sign(
+                    st_ctx.key_indices[i], st_ctx.raw_transaction,
+                    st_ctx.raw_transaction_length,
+                    G_io_apdu_buffer + st_ctx.signature_length,
+                    &signature_length);
+                st_ctx.signature_length += signature_length;
+            }
+            break;
+
+        case ReviewedTwoPass:
+            signed_ok = hedera_stream_sign_final(
+                st_ctx.key_index, &st_ctx.two_pass.sign, G_io_apdu_buffer,
+                &st_ctx.signature_length);
+            break;
+
+        case ReviewedEcdsa:
+            signed_ok = hedera_sign_ecdsa(st_ctx.key_index, st_ctx.ecdsa.digest,
+                                          G_io_apdu_buffer,
+                                          &st_ctx.signature_length);
+            break;
+
+        case ReviewedBatch:
+            // The body is kept for the following nodes
+            if (batch_sign_next(G_io_apdu_buffer, &st_ctx.signature_length)) {
+                return true;
+            }
+            break;
+
+        case ReviewedQueue:
+            // Queue signatures are served by handle_queue_signature, once
+            // every queued body has been answered
+            break;
+
+        default:
+            break;
+    }
+
+    // Resending this body gets the same signature back without a review
+    if (signed_ok && st_ctx.reviewed_body == ReviewedRaw &&
+        st_ctx.key_count == 1) {
+        hedera_signature_cache_add(st_ctx.key_index, st_ctx.raw_transaction,
+                                   st_ctx.raw_transaction_length,
+                                   G_io_apdu_buffer);
+    }
+
+    if (!signed_ok) {
+        PRINTF("%s: signature failure\n", __func__);
+        MEMCLEAR(G_io_apdu_buffer);
+        st_ctx.signature_length = 0;
     }
+
+    drop_reviewed_transaction();
+    return signed_ok;
+}
+
+// StringValue.value of the account memo, which nanopb leaves to a callback:
+// kept up to the size of st_ctx.account_memo, the rest is skipped
+static bool decode_account_memo(pb_istream_t* stream, const pb_field_t* field,
+                                void** arg) {
+    UNUSED(field);
+    UNUSED(arg);
+
+    size_t length = stream->bytes_left;
+    if (length > sizeof(st_ctx.account_memo) - 1) {
+        length = sizeof(st_ctx.account_memo) - 1;
+    }
+
+    MEMCLEAR(st_ctx.account_memo);
+    return pb_read(stream, (pb_byte_t*)st_ctx.account_memo, length) &&
+           pb_read(stream, NULL, stream->bytes_left);
+}
+
+// Called as a cryptoUpdateAccount starts, once nanopb has cleared it
+static bool start_crypto_update(pb_istream_t* stream, const pb_field_t* field,
+                                void** arg) {
+    UNUSED(stream);
+    UNUSED(arg);
+
+    Hedera_CryptoUpdateTransactionBody* update = field->pData;
+    update->memo.value.funcs.decode = decode_account_memo;
+
+    // Unless the body sets one
+    strcpy(st_ctx.account_memo, "-");
+    return true;
 }
 
-void handle_transaction_body() {
+void capture_account_memo(void) {
+    st_ctx.transaction.cb_data.funcs.decode = start_crypto_update;
+}
+
+void format_transaction_body(void) {
     MEMCLEAR(st_ctx.summary_line_1);
     MEMCLEAR(st_ctx.summary_line_2);
     MEMCLEAR(st_ctx.amount_title);
@@ -145,6 +301,7 @@ void handle_transaction_body() {
     MEMCLEAR(st_ctx.expiration_time);
     MEMCLEAR(st_ctx.receiver_sig_required);
     MEMCLEAR(st_ctx.max_auto_token_assoc);
+    MEMCLEAR(st_ctx.new_key);
 
     // Step 1, Unknown Type, Screen 1 of 1
     st_ctx.type = Unknown;
@@ -196,6 +353,7 @@ void handle_transaction_body() {
                 default:
                     reformat_summary("update account");
                     reformat_updated_account();
+                    reformat_new_key();
                     reformat_stake_target();
                     reformat_auto_renew_period();
                     reformat_expiration_time();
@@ -307,7 +465,7 @@ void handle_transaction_body() {
 
             } else {
                 // Unsupported
-                THROW(EXCEPTION_MALFORMED_APDU);
+                REFUSE(REFUSAL_UNSUPPORTED);
             }
             break;
 
@@ -320,7 +478,7 @@ void handle_transaction_body() {
 
         default:
             // Unsupported
-            THROW(EXCEPTION_MALFORMED_APDU);
+            REFUSE(REFUSAL_UNSUPPORTED);
             break;
     }
 
@@ -329,137 +487,482 @@ void handle_transaction_body() {
         reformat_fee();
         reformat_memo();
     }
+}
+
+#ifdef HAVE_SWAP
+// A plain Hbar transfer between two accounts, the only body Exchange sends
+static bool is_swap_transfer(void) {
+    return st_ctx.transaction.which_data ==
+               Hedera_TransactionBody_cryptoTransfer_tag &&
+           is_transfer() &&
+           st_ctx.transaction.data.cryptoTransfer.tokenTransfers_count == 0 &&
+           is_hbar_amounts_valid();
+}
+
+// Exchange already displayed the transaction: its amount, fee and recipient
+// are checked against the validated ones straight from the decoded body,
+// nothing is formatted for display
+static void __attribute__((noreturn)) handle_swap_transaction_body(void) {
+    if (G_swap_response_ready) {
+        // Safety against trying to make the app sign multiple TX
+        // This code should never be triggered as the app is supposed to
+        // exit after sending the signed transaction
+        PRINTF("Safety against double signing triggered\n");
+        os_sched_exit(-1);
+    }
+
+    // We will quit the app after this transaction, whether it succeeds
+    // or fails
+    PRINTF("Swap response is ready, the app will quit after the next send\n");
+    // This boolean will make the io_send_sw family instant reply +
+    // return to exchange
+    G_swap_response_ready = true;
+
+    bool swap_valid = false;
+    if (is_swap_transfer() && swap_check_validity()) {
+        PRINTF("Swap response validated\n");
+        swap_valid = sign_reviewed_transaction();
+    }
+
+    uint8_t tx = 0;
+    if (swap_valid) {
+        tx = st_ctx.signature_length;
+        U2BE_ENCODE(G_io_apdu_buffer, tx, EXCEPTION_OK);
+    } else {
+        PRINTF("swap_check_validity failed\n");
+        drop_reviewed_transaction();
+        U2BE_ENCODE(G_io_apdu_buffer, tx, EXCEPTION_INTERNAL);
+    }
+    tx += 2;
+
+    // Send back the response, do not restart the event loop
+    io_exchange(CHANNEL_APDU | IO_RETURN_AFTER_TX, tx);
+    finalize_exchange_sign_transaction(swap_valid);
+}
+#endif
 
+void handle_transaction_body(void) {
 #ifdef HAVE_SWAP
     // If we are in swap context, do not redisplay the message data
     // Instead, ensure they are identical with what was previously displayed
     if (G_called_from_swap) {
-        if (G_swap_response_ready) {
-            // Safety against trying to make the app sign multiple TX
-            // This code should never be triggered as the app is supposed to
-            // exit after sending the signed transaction
-            PRINTF("Safety against double signing triggered\n");
-            os_sched_exit(-1);
-        } else {
-            // We will quit the app after this transaction, whether it succeeds
-            // or fails
-            PRINTF(
-                "Swap response is ready, the app will quit after the next "
-                "send\n");
-            // This boolean will make the io_send_sw family instant reply +
-            // return to exchange
-            G_swap_response_ready = true;
+        handle_swap_transaction_body();
+    }
+#endif
+
+    format_transaction_body();
+    ui_sign_transaction();
+}
+
+// Decode the body (preceded by its total length when announced) while the
+// chunks arrive, keeping a single copy of it for signing
+void decode_raw_transaction(uint8_t ins, uint8_t p2, bool length_prefixed,
+                            uint8_t* buffer, uint16_t len) {
+    uint16_t raw_transaction_length = len;
+    if (length_prefixed) {
+        if (len < BODY_LENGTH_SIZE) {
+            REFUSE(REFUSAL_DECODE);
         }
-        if (swap_check_validity()) {
-            PRINTF("Swap response validated\n");
-            validate_transfer();
+        raw_transaction_length = U2LE(buffer, 0);
+        buffer += BODY_LENGTH_SIZE;
+        len -= BODY_LENGTH_SIZE;
+    }
 
-            uint8_t tx = st_ctx.signature_length;
+    // Checking transaction length
+    if (raw_transaction_length == 0 || raw_transaction_length > MAX_TX_SIZE ||
+        raw_transaction_length < len) {
+        PRINTF("%s: wrong transaction length\n", __func__);
+        REFUSE(REFUSAL_DECODE);
+    }
 
-            U2BE_ENCODE(G_io_apdu_buffer, tx, EXCEPTION_OK);
-            tx += 2;
+    tx_stream_t body_stream;
+    tx_stream_init(&body_stream, ins, buffer, len, !(p2 & P2_MORE),
+                   st_ctx.raw_transaction, sizeof(st_ctx.raw_transaction));
+    pb_istream_t stream =
+        tx_stream_istream(&body_stream, raw_transaction_length);
 
-            // Send back the response, do not restart the event loop
-            io_exchange(CHANNEL_APDU | IO_RETURN_AFTER_TX, tx);
-            finalize_exchange_sign_transaction(true);
-        } else {
-            PRINTF("swap_check_validity failed\n");
-            uint8_t tx = 0;
+    capture_account_memo();
+    if (!Hedera_TransactionBody_decode(&stream, &st_ctx.transaction) ||
+        !tx_stream_finished(&body_stream)) {
+        // Oh no couldn't ...
+        PRINTF("%s: decoding failure\n", __func__);
+        MEMCLEAR(G_io_apdu_buffer);
+        MEMCLEAR(st_ctx.raw_transaction);
+        REFUSE(REFUSAL_DECODE);
+    }
+    st_ctx.raw_transaction_length = body_stream.body_length;
+}
 
-            U2BE_ENCODE(G_io_apdu_buffer, tx, EXCEPTION_INTERNAL);
-            tx += 2;
+// Answer a body already approved in this session for the same key, which
+// hosts resend after a dropped connection, with its signature
+static bool answer_resent_body(void) {
+    uint16_t length = ED25519_SIGNATURE_SIZE;
 
-            // Send back the response, do not restart the event loop
-            io_exchange(CHANNEL_APDU | IO_RETURN_AFTER_TX, tx);
+#ifdef HAVE_SWAP
+    // Exchange approves a single transaction per session
+    if (G_called_from_swap) {
+        return false;
+    }
+#endif
 
-            finalize_exchange_sign_transaction(false);
+    if (!hedera_signature_cache_find(st_ctx.key_index, st_ctx.raw_transaction,
+                                     st_ctx.raw_transaction_length,
+                                     G_io_apdu_buffer)) {
+        return false;
+    }
+
+    if (st_ctx.append_public_key) {
+        if (!hedera_get_public_key(st_ctx.key_index,
+                                   G_io_apdu_buffer + length)) {
+            MEMCLEAR(G_io_apdu_buffer);
+            return false;
         }
-    } else {
-        ui_sign_transaction();
+        length += PUBKEY_LENGTH;
     }
-#else
-    ui_sign_transaction();
-#endif
 
-    ui_sign_transaction();
+    drop_reviewed_transaction();
+    io_exchange_with_code(EXCEPTION_OK, length);
+    return true;
 }
 
 // Sign Handler
 // Decodes and handles transaction message
+//
+// The body either fits a single APDU (P2 == 0):
+//   index (4, LE) | body
+// or is split across several APDUs (see tx_stream.h for the P2 flags), the
+// first one announcing the total body length:
+//   index (4, LE) | body length (2, LE) | body...
+// Following chunks carry only body bytes; they are pulled by the decoder as
+// it needs them and acknowledged with 0x9000.
+// The approval answers with the signature (64 bytes), followed with
+// P1_SIGNATURE_AND_KEY by the public key of the signing key (32 bytes).
+// With P2_KEEP_KEY on the first APDU, the signing key is kept for the next
+// requests with this flag on the same index, within the limits of
+// hedera_sign_keep_key.
+// A body approved earlier in the session for the same index, among the last
+// SIGNATURE_CACHE_SIZE ones, is answered straight away with its signature.
 void handle_sign_transaction(uint8_t p1, uint8_t p2, uint8_t* buffer,
                              uint16_t len,
                              /* out */ volatile unsigned int* flags,
                              /* out */ volatile unsigned int* tx) {
-    UNUSED(p1);
-    UNUSED(p2);
     UNUSED(tx);
 
-    // Raw Tx
-    uint8_t raw_transaction[MAX_TX_SIZE];
-
     // Checking input parameters
     if ((buffer == NULL) || (len <= INDEX_SIZE)) {
         PRINTF("%s: wrong buffer pointer or input length\n", __func__);
         THROW(EXCEPTION_MALFORMED_APDU);
     }
 
-    uint16_t raw_transaction_length = len - INDEX_SIZE;
-    // Checking transaction length
-    // Unnecessary check today as MAX_TX_SIZE is set to 512 bytes,
-    // but APDU length field occupies only 1 byte.
-    // TODO: to set correct MAX_TX_SIZE and maybe to transform uint16_t len to
-    // uint8_t
-    if (raw_transaction_length > MAX_TX_SIZE) {
-        PRINTF("%s: too big transaction length\n", __func__);
+    // A continuation chunk without a preceding first chunk
+    if (p2 & P2_EXTEND) {
+        PRINTF("%s: unexpected continuation chunk\n", __func__);
         THROW(EXCEPTION_MALFORMED_APDU);
     }
 
+    drop_pending_requests();
+
     // Key Index (Little Endian format)
     st_ctx.key_index = U4LE(buffer, 0);
+    buffer += INDEX_SIZE;
+    len -= INDEX_SIZE;
+
+    decode_raw_transaction(INS_SIGN_TRANSACTION, p2, p2 & P2_MORE, buffer,
+                           len);
+
+    // Signed with this key once approved
+    st_ctx.append_public_key = (p1 == P1_SIGNATURE_AND_KEY);
+    st_ctx.keep_signing_key = (p2 & P2_KEEP_KEY);
+    st_ctx.key_indices[0] = st_ctx.key_index;
+    st_ctx.reviewed_body = ReviewedRaw;
 
-    // copy raw transaction.
-    // using simply memcpy() as the overlap between the
-    // local and global buffers is impossible.
-    memcpy(raw_transaction, (buffer + INDEX_SIZE), raw_transaction_length);
+    if (!answer_resent_body()) {
+        handle_transaction_body();
+    }
 
-    // Make in memory buffer into stream
+    *flags |= IO_ASYNCH_REPLY;
+}
+
+// Multi-Key Sign Handler
+// Signs one reviewed body with several keys, e.g. an account key update that
+// must be signed by both the old and the new key.
+//
+//   key count (1) | indices (count * 4, LE) | body length (2, LE) | body...
+// optionally split across APDUs with the P2 flags of tx_stream.h.
+// The approval answers with the signatures (64 bytes each) in request order.
+void handle_sign_transaction_multi(uint8_t p1, uint8_t p2, uint8_t* buffer,
+                                   uint16_t len,
+                                   /* out */ volatile unsigned int* flags,
+                                   /* out */ volatile unsigned int* tx) {
+    UNUSED(p1);
+    UNUSED(tx);
+
+    if (buffer == NULL || len < 1) {
+        PRINTF("%s: wrong buffer pointer or input length\n", __func__);
+        THROW(EXCEPTION_MALFORMED_APDU);
+    }
+
+    // A continuation chunk without a preceding first chunk
+    if (p2 & P2_EXTEND) {
+        PRINTF("%s: unexpected continuation chunk\n", __func__);
+        THROW(EXCEPTION_MALFORMED_APDU);
+    }
+
+#ifdef HAVE_SWAP
+    // Exchange expects exactly one signature
+    if (G_called_from_swap) {
+        THROW(EXCEPTION_MALFORMED_APDU);
+    }
+#endif
+
+    uint8_t key_count = buffer[0];
+    if (key_count == 0 || key_count > MAX_SIGNING_KEYS ||
+        len < 1 + key_count * INDEX_SIZE + BODY_LENGTH_SIZE) {
+        PRINTF("%s: wrong key count\n", __func__);
+        THROW(EXCEPTION_MALFORMED_APDU);
+    }
+
+    drop_pending_requests();
+
+    // Key Indices (Little Endian format)
+    for (uint8_t i = 0; i < key_count; i++) {
+        st_ctx.key_indices[i] = U4LE(buffer, 1 + i * INDEX_SIZE);
+    }
+    st_ctx.key_count = key_count;
+    st_ctx.key_index = st_ctx.key_indices[0];
+    buffer += 1 + key_count * INDEX_SIZE;
+    len -= 1 + key_count * INDEX_SIZE;
+
+    // The body length is always announced
+    decode_raw_transaction(INS_SIGN_TRANSACTION_MULTI, p2, true, buffer, len);
+
+    // Signed with every key once approved
+    st_ctx.reviewed_body = ReviewedRaw;
+
+    handle_transaction_body();
+
+    *flags |= IO_ASYNCH_REPLY;
+}
+
+// Both passes feed the Ed25519 hash and the running body digest
+static bool two_pass_sink(void* sink_ctx, const uint8_t* data,
+                                size_t length) {
+    UNUSED(sink_ctx);
+    return hedera_stream_sign_update(&st_ctx.two_pass.sign, data, length) &&
+           CX_OK == cx_hash_no_throw(&st_ctx.two_pass.body_hash.header, 0,
+                                     data, length, NULL, 0);
+}
+
+static void two_pass_abort(void) {
+    st_ctx.two_pass_pending = false;
+    MEMCLEAR(st_ctx.two_pass);
+    THROW(EXCEPTION_MALFORMED_APDU);
+}
+
+// First pass: decode the body and derive the Ed25519 nonce from it
+static void handle_first_pass(uint8_t p2, uint8_t* buffer, uint16_t len) {
+    drop_pending_requests();
+    MEMCLEAR(st_ctx.two_pass);
+
+    if (len < INDEX_SIZE + STREAM_BODY_LENGTH_SIZE) {
+        PRINTF("%s: wrong input length\n", __func__);
+        THROW(EXCEPTION_MALFORMED_APDU);
+    }
+
+    // Key Index (Little Endian format)
+    st_ctx.key_index = U4LE(buffer, 0);
+    st_ctx.two_pass.body_length = U4LE(buffer, INDEX_SIZE);
+    buffer += INDEX_SIZE + STREAM_BODY_LENGTH_SIZE;
+    len -= INDEX_SIZE + STREAM_BODY_LENGTH_SIZE;
+
+    if (st_ctx.two_pass.body_length == 0 ||
+        st_ctx.two_pass.body_length < len) {
+        PRINTF("%s: wrong transaction length\n", __func__);
+        two_pass_abort();
+    }
+
+    if (!hedera_stream_sign_init(st_ctx.key_index, &st_ctx.two_pass.sign) ||
+        CX_OK != cx_sha256_init_no_throw(&st_ctx.two_pass.body_hash)) {
+        PRINTF("%s: signature failure\n", __func__);
+        two_pass_abort();
+    }
+
+    tx_stream_t body_stream;
+    tx_stream_init(&body_stream, INS_SIGN_TRANSACTION_STREAM, buffer, len,
+                   !(p2 & P2_MORE), NULL, 0);
+    tx_stream_set_sink(&body_stream, two_pass_sink, NULL);
     pb_istream_t stream =
-        pb_istream_from_buffer(raw_transaction, raw_transaction_length);
+        tx_stream_istream(&body_stream, st_ctx.two_pass.body_length);
 
-    // Decode the Transaction
-    if (!pb_decode(&stream, Hedera_TransactionBody_fields,
-                   &st_ctx.transaction)) {
-        // Oh no couldn't ...
+    capture_account_memo();
+    if (!Hedera_TransactionBody_decode(&stream, &st_ctx.transaction) ||
+        !tx_stream_finished(&body_stream)) {
         PRINTF("%s: decoding failure\n", __func__);
-        MEMCLEAR(G_io_apdu_buffer);
-        MEMCLEAR(raw_transaction);
+        two_pass_abort();
+    }
+
+    if (CX_OK != cx_hash_no_throw(&st_ctx.two_pass.body_hash.header, CX_LAST,
+                                  NULL, 0, st_ctx.two_pass.body_digest,
+                                  sizeof(st_ctx.two_pass.body_digest)) ||
+        !hedera_stream_sign_nonce(&st_ctx.two_pass.sign) ||
+        CX_OK != cx_sha256_init_no_throw(&st_ctx.two_pass.body_hash)) {
+        PRINTF("%s: signature failure\n", __func__);
+        two_pass_abort();
+    }
+
+    st_ctx.two_pass_pending = true;
+}
+
+// Second pass: check the body is unchanged and finish the signature
+static void handle_second_pass(uint8_t p2, uint8_t* buffer, uint16_t len) {
+    uint8_t body_digest[CX_SHA256_SIZE];
+
+    if (!st_ctx.two_pass_pending) {
+        PRINTF("%s: no first pass\n", __func__);
         THROW(EXCEPTION_MALFORMED_APDU);
     }
+    st_ctx.two_pass_pending = false;
 
-    // Extract account memo from cryptoUpdateAccount using second-stage protobuf
-    // decoding This handles the nested StringValue structure that nanopb
-    // doesn't decode automatically
-    if (st_ctx.transaction.which_data ==
-        Hedera_TransactionBody_cryptoUpdateAccount_tag) {
-        if (!extract_nested_string_field(
-                raw_transaction, raw_transaction_length, 14,
-                st_ctx.account_memo, sizeof(st_ctx.account_memo))) {
-            strcpy(st_ctx.account_memo, "-");
-        }
+    if (st_ctx.two_pass.body_length < len) {
+        PRINTF("%s: wrong transaction length\n", __func__);
+        two_pass_abort();
     }
 
-    // Sign Transaction
-    if (!hedera_sign(st_ctx.key_index, raw_transaction, raw_transaction_length,
-                     G_io_apdu_buffer, &st_ctx.signature_length)) {
-        PRINTF("%s: signature failure\n", __func__);
-        MEMCLEAR(G_io_apdu_buffer);
-        MEMCLEAR(raw_transaction);
+    tx_stream_t body_stream;
+    tx_stream_init(&body_stream, INS_SIGN_TRANSACTION_STREAM, buffer, len,
+                   !(p2 & P2_MORE), NULL, 0);
+    tx_stream_set_sink(&body_stream, two_pass_sink, NULL);
+
+    if (!tx_stream_skip(&body_stream, st_ctx.two_pass.body_length) ||
+        !tx_stream_finished(&body_stream) ||
+        CX_OK != cx_hash_no_throw(&st_ctx.two_pass.body_hash.header, CX_LAST,
+                                  NULL, 0, body_digest, sizeof(body_digest)) ||
+        memcmp(body_digest, st_ctx.two_pass.body_digest,
+               sizeof(body_digest)) != 0) {
+        PRINTF("%s: body differs from the first pass\n", __func__);
+        two_pass_abort();
+    }
+
+    // The signature is finished once approved
+    st_ctx.reviewed_body = ReviewedTwoPass;
+
+    handle_transaction_body();
+}
+
+static bool ecdsa_sink(void* sink_ctx, const uint8_t* data, size_t length) {
+    UNUSED(sink_ctx);
+    return CX_OK == cx_hash_no_throw(&st_ctx.ecdsa.hash.header, 0, data,
+                                     length, NULL, 0);
+}
+
+static void ecdsa_abort(void) {
+    MEMCLEAR(st_ctx.ecdsa);
+    THROW(EXCEPTION_MALFORMED_APDU);
+}
+
+// Single pass: decode the body for display while hashing it
+static void handle_ecdsa(uint8_t p2, uint8_t* buffer, uint16_t len) {
+    drop_pending_requests();
+
+    if (len < INDEX_SIZE + STREAM_BODY_LENGTH_SIZE) {
+        PRINTF("%s: wrong input length\n", __func__);
         THROW(EXCEPTION_MALFORMED_APDU);
-                     }
+    }
+
+    // Key Index (Little Endian format)
+    st_ctx.key_index = U4LE(buffer, 0);
+    uint32_t body_length = U4LE(buffer, INDEX_SIZE);
+    buffer += INDEX_SIZE + STREAM_BODY_LENGTH_SIZE;
+    len -= INDEX_SIZE + STREAM_BODY_LENGTH_SIZE;
+
+    if (body_length == 0 || body_length < len) {
+        PRINTF("%s: wrong transaction length\n", __func__);
+        ecdsa_abort();
+    }
+
+    if (CX_OK != cx_keccak_init_no_throw(&st_ctx.ecdsa.hash, 256)) {
+        PRINTF("%s: hash failure\n", __func__);
+        ecdsa_abort();
+    }
 
-    MEMCLEAR(raw_transaction);
+    tx_stream_t body_stream;
+    tx_stream_init(&body_stream, INS_SIGN_TRANSACTION_STREAM, buffer, len,
+                   !(p2 & P2_MORE), NULL, 0);
+    tx_stream_set_sink(&body_stream, ecdsa_sink, NULL);
+    pb_istream_t stream = tx_stream_istream(&body_stream, body_length);
+
+    capture_account_memo();
+    if (!Hedera_TransactionBody_decode(&stream, &st_ctx.transaction) ||
+        !tx_stream_finished(&body_stream)) {
+        PRINTF("%s: decoding failure\n", __func__);
+        ecdsa_abort();
+    }
+
+    if (CX_OK != cx_hash_no_throw(&st_ctx.ecdsa.hash.header, CX_LAST, NULL, 0,
+                                  st_ctx.ecdsa.digest,
+                                  sizeof(st_ctx.ecdsa.digest))) {
+        PRINTF("%s: hash failure\n", __func__);
+        ecdsa_abort();
+    }
+
+    // The digest is signed once approved
+    st_ctx.reviewed_body = ReviewedEcdsa;
 
     handle_transaction_body();
+}
+
+// Stream Sign Handler
+// Signs bodies of any size without holding them in RAM.
+//
+// Ed25519 hashes the message twice, so the host streams the body twice.
+// First pass (P1_FIRST_PASS), decoded for display:
+//   index (4, LE) | body length (4, LE) | body...
+// Second pass (P1_SECOND_PASS), the same body again:
+//   body...
+// The first pass is acknowledged with 0x9000, the second one with the
+// signature once the user approved it.
+//
+// secp256k1 (P1_ECDSA) signs the Keccak-256 digest of the body, computed in
+// a single pass, with the key at m/44'/3030'/0'/0'/index':
+//   index (4, LE) | body length (4, LE) | body...
+// answered with r || s (64 bytes, low s) once the user approved it.
+//
+// Each pass may be split across several APDUs with the P2 flags of
+// tx_stream.h.
+void handle_sign_transaction_stream(uint8_t p1, uint8_t p2, uint8_t* buffer,
+                                    uint16_t len,
+                                    /* out */ volatile unsigned int* flags,
+                                    /* out */ volatile unsigned int* tx) {
+    UNUSED(tx);
+
+    if (buffer == NULL) {
+        PRINTF("%s: wrong buffer pointer\n", __func__);
+        THROW(EXCEPTION_MALFORMED_APDU);
+    }
+
+    // A continuation chunk without a preceding first chunk
+    if (p2 & P2_EXTEND) {
+        PRINTF("%s: unexpected continuation chunk\n", __func__);
+        THROW(EXCEPTION_MALFORMED_APDU);
+    }
+
+    switch (p1) {
+        case P1_FIRST_PASS:
+            handle_first_pass(p2, buffer, len);
+            io_exchange_with_code(EXCEPTION_OK, 0);
+            break;
+
+        case P1_SECOND_PASS:
+            handle_second_pass(p2, buffer, len);
+            break;
+
+        case P1_ECDSA:
+            handle_ecdsa(p2, buffer, len);
+            break;
+
+        default:
+            THROW(EXCEPTION_MALFORMED_APDU);
+    }
 
     *flags |= IO_ASYNCH_REPLY;
 }
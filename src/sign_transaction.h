@@ -9,7 +9,9 @@
 #include "tokens/cal/token_lookup.h"
 #include "tokens/token_address.h"
 #include "transaction_body.pb.h"
+#include "transaction_body_decode.h"
 #include "staking.h"
+#include "app_globals.h"
 
 // NO_BOLOS_SDK: exclude device-only headers when building tests/fuzzers
 #ifndef NO_BOLOS_SDK
@@ -17,7 +19,6 @@
 #include "crypto_update.pb.h"
 #include "handlers.h"
 #include "hedera.h"
-#include "app_globals.h"
 #include "hedera_format.h"
 #include "app_io.h"
 #include "ui_common.h"
@@ -93,9 +94,76 @@ transactions, and the additional transactions have been added since then. Steps
 may be skipped or modified (as described above) from the original transfer flow.
  */
 
+// P1 of INS_SIGN_TRANSACTION. Hosts send 0x00 or 0x01 (P1_NON_CONFIRM), both
+// answered with the signature only
+#define P1_SIGNATURE 0x00         // Signature only
+#define P1_SIGNATURE_AND_KEY 0x02 // Signature followed by the public key
+
+// P2 of INS_SIGN_TRANSACTION, along with the chunk flags of tx_stream.h:
+// keep the signing key for the next requests with this flag on the same index
+#define P2_KEEP_KEY 0x04
+
+// Why a transaction is refused, reported by INS_VALIDATE_TRANSACTION
+typedef enum {
+    REFUSAL_NONE = 0x00,
+    REFUSAL_DECODE = 0x01,              // Malformed body or request
+    REFUSAL_UNSUPPORTED = 0x02,         // Transaction type not supported
+    REFUSAL_TOO_MANY_TRANSFERS = 0x03,  // More than two accounts
+    REFUSAL_MIXED_TRANSFER = 0x04,      // Hbar and tokens in one transfer
+    REFUSAL_UNBALANCED_TRANSFER = 0x05, // Hbar amounts do not sum to zero
+    REFUSAL_TOO_MANY_TOKENS = 0x06,     // More than one token transferred
+    REFUSAL_BAD_DECIMALS = 0x07,        // Token decimals of 20 or more
+    REFUSAL_MEMO_TOO_LONG = 0x08,
+    REFUSAL_ZERO_ACCOUNT = 0x09,        // Update of account 0.0.0
+    REFUSAL_KEY_UPDATE = 0x0A,          // Key update not signed by two keys
+    REFUSAL_UNSUPPORTED_SELECTOR = 0x0B,
+    REFUSAL_CONTRACT_CALL = 0x0C,       // Malformed contract call
+} refusal_reason_t;
+
+// Refuse the transaction, recording why
+#define REFUSE(reason)                    \
+    do {                                  \
+        st_ctx.refusal_reason = (reason); \
+        THROW(EXCEPTION_MALFORMED_APDU);  \
+    } while (0)
+
+// Body waiting for the user's approval to be signed
+enum ReviewedBody {
+    ReviewedNone = 0,
+    ReviewedRaw = 1,     // raw_transaction, signed with every key
+    ReviewedTwoPass = 2, // two_pass, hashed twice already
+    ReviewedBatch = 3,   // raw_transaction, signed for the next node
+    ReviewedQueue = 4,   // raw_transaction, a copy of a queued body
+    ReviewedEcdsa = 5,   // ecdsa, digest of a streamed body
+};
+
+#ifndef NO_BOLOS_SDK
+// State of a two-pass signature (INS_SIGN_TRANSACTION_STREAM) between the
+// passes; the body itself is never stored
+typedef struct two_pass_ctx_s {
+    hedera_stream_sign_t sign;
+
+    // Running digest of the body, compared across the two passes
+    cx_sha256_t body_hash;
+    uint8_t body_digest[CX_SHA256_SIZE];
+    uint32_t body_length;
+} two_pass_ctx_t;
+
+// State of a secp256k1 signature (INS_SIGN_TRANSACTION_STREAM, P1_ECDSA);
+// the body is hashed as it is decoded and never stored
+typedef struct ecdsa_ctx_s {
+    cx_sha3_t hash;
+    uint8_t digest[CX_SHA3_256_SIZE];
+} ecdsa_ctx_t;
+#endif
+
 typedef struct sign_tx_context_s {
     // ui common
     uint32_t key_index;
+
+    // Keys signing the transaction, key_index is the first one
+    uint32_t key_indices[MAX_SIGNING_KEYS];
+    uint8_t key_count;
     uint8_t transfer_to_index;
     uint8_t transfer_from_index;
 
@@ -103,8 +171,8 @@ typedef struct sign_tx_context_s {
     char summary_line_1[FULL_ADDRESS_LENGTH + 1];
     char summary_line_2[DISPLAY_SIZE + 1];
 
-    //Key Index in str
-    char key_index_str[DISPLAY_SIZE + 1];
+    //Key Index in str, "#4294967295, " per key
+    char key_index_str[MAX_SIGNING_KEYS * 13 + 1];
 
 #if defined(TARGET_NANOS)
     union {
@@ -192,12 +260,69 @@ typedef struct sign_tx_context_s {
     // Important: This is a whole account memo, not the memo field in the transaction body
     // Currently hedera limits memo to 100 characters
     char account_memo[100];
+    // New ed25519 key of the account (hex)
+    char new_key[KEY_SIZE + 1];
 #endif
 
     // Parsed transaction
     Hedera_TransactionBody transaction;
 
+    union {
+        // Raw transaction body as received, kept for signing
+        uint8_t raw_transaction[MAX_TX_SIZE];
+#ifndef NO_BOLOS_SDK
+        // Two-pass signature, for bodies not kept in RAM
+        two_pass_ctx_t two_pass;
+
+        // secp256k1 signature, for bodies not kept in RAM
+        ecdsa_ctx_t ecdsa;
+#endif
+    };
+    uint16_t raw_transaction_length;
+
+    // First pass of a two-pass signature done, waiting for the second one
+    bool two_pass_pending;
+
+    // Signed only once the review is approved
+    enum ReviewedBody reviewed_body;
+
+    // Append the public key to the signature (P1_SIGNATURE_AND_KEY)
+    bool append_public_key;
+
+    // Sign with the kept key of the index (P2_KEEP_KEY)
+    bool keep_signing_key;
+
+    // Set when the transaction is refused
+    refusal_reason_t refusal_reason;
+
     size_t signature_length;
 } sign_tx_context_t;
 
 extern sign_tx_context_t st_ctx;
+
+// A new sign request drops whatever a previous one left pending
+void drop_pending_requests(void);
+
+// Derived keys and approved requests do not outlive a device lock
+void drop_session_on_lock(void);
+
+// Sign the reviewed body into G_io_apdu_buffer (signature_length bytes)
+bool sign_reviewed_transaction(void);
+
+// Wipe the reviewed body, e.g. when the review is rejected
+void drop_reviewed_transaction(void);
+
+// Decode a body received with INS ins into st_ctx.raw_transaction and
+// st_ctx.transaction, pulling the following chunks as needed
+void decode_raw_transaction(uint8_t ins, uint8_t p2, bool length_prefixed,
+                            uint8_t* buffer, uint16_t len);
+
+// Have the next decoding of st_ctx.transaction fill st_ctx.account_memo
+// when the body is a cryptoUpdateAccount
+void capture_account_memo(void);
+
+// Validate and format the decoded transaction
+void format_transaction_body(void);
+
+// Validate and format the decoded transaction, then start the review
+void handle_transaction_body(void);
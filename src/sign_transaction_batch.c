@@ -0,0 +1,236 @@
+#include "sign_transaction_batch.h"
+
+#include <pb_encode.h>
+#include <string.h>
+
+#include "proto_varlen_parser.h"
+#include "sign_transaction.h"
+#include "tx_stream.h"
+
+// Re-encoded nodeAccountID: tag and length prefix fit one byte each
+#define NODE_FIELD_MAX_SIZE (2 + Hedera_AccountID_size)
+
+batch_context_t batch_ctx;
+
+void batch_reset(void) {
+    // raw_transaction is shared with the two-pass state, only wipe our body
+    if (batch_ctx.node_count != 0) {
+        MEMCLEAR(st_ctx.raw_transaction);
+        st_ctx.raw_transaction_length = 0;
+    }
+    MEMCLEAR(batch_ctx);
+}
+
+void batch_approved(void) {
+    if (batch_ctx.state != BATCH_REVIEW) {
+        return;
+    }
+
+    if (batch_ctx.next_node < batch_ctx.node_count) {
+        batch_ctx.state = BATCH_APPROVED;
+    } else {
+        batch_reset();
+    }
+}
+
+static int64_t read_node_number(const uint8_t* buffer, size_t offset) {
+    return (int64_t)((uint64_t)U4LE(buffer, offset) |
+                     ((uint64_t)U4LE(buffer, offset + 4) << 32));
+}
+
+// Replace nodeAccountID in the kept body with the next node, then sign it
+bool batch_sign_next(/* out */ uint8_t* result, /* out */ size_t* sig_len_out) {
+    uint8_t node = batch_ctx.next_node;
+    if (node >= batch_ctx.node_count) {
+        return false;
+    }
+    batch_ctx.next_node++;
+
+    Hedera_AccountID account = Hedera_AccountID_init_zero;
+    account.shardNum = batch_ctx.nodes[node].shard;
+    account.realmNum = batch_ctx.nodes[node].realm;
+    account.which_account = Hedera_AccountID_accountNum_tag;
+    account.account.accountNum = batch_ctx.nodes[node].account;
+
+    uint8_t field[NODE_FIELD_MAX_SIZE];
+    pb_ostream_t ostream = pb_ostream_from_buffer(field, sizeof(field));
+    if (!pb_encode_tag(&ostream, PB_WT_STRING,
+                       Hedera_TransactionBody_nodeAccountID_tag) ||
+        !pb_encode_submessage(&ostream, Hedera_AccountID_fields, &account)) {
+        return false;
+    }
+
+    size_t tail_length = st_ctx.raw_transaction_length -
+                         batch_ctx.node_field_offset -
+                         batch_ctx.node_field_length;
+    size_t new_length = batch_ctx.node_field_offset + ostream.bytes_written +
+                        tail_length;
+    if (new_length > sizeof(st_ctx.raw_transaction)) {
+        return false;
+    }
+
+    uint8_t* field_start = st_ctx.raw_transaction + batch_ctx.node_field_offset;
+    memmove(field_start + ostream.bytes_written,
+            field_start + batch_ctx.node_field_length, tail_length);
+    memcpy(field_start, field, ostream.bytes_written);
+    batch_ctx.node_field_length = ostream.bytes_written;
+    st_ctx.raw_transaction_length = new_length;
+
+    return hedera_sign(st_ctx.key_index, st_ctx.raw_transaction,
+                       st_ctx.raw_transaction_length, result, sig_len_out);
+}
+
+// Decode the body and node list, sign for the first node and start the review
+static void handle_batch_start(uint8_t p2, uint8_t* buffer, uint16_t len) {
+    if (buffer == NULL || len < BATCH_HEADER_SIZE) {
+        PRINTF("%s: wrong buffer pointer or input length\n", __func__);
+        THROW(EXCEPTION_MALFORMED_APDU);
+    }
+
+    // A continuation chunk without a preceding first chunk
+    if (p2 & P2_EXTEND) {
+        PRINTF("%s: unexpected continuation chunk\n", __func__);
+        THROW(EXCEPTION_MALFORMED_APDU);
+    }
+
+#ifdef HAVE_SWAP
+    // Exchange expects exactly one signature
+    if (G_called_from_swap) {
+        THROW(EXCEPTION_MALFORMED_APDU);
+    }
+#endif
+
+    // Key Index (Little Endian format)
+    st_ctx.key_index = U4LE(buffer, 0);
+    uint8_t node_count = buffer[INDEX_SIZE];
+    uint16_t body_length = U2LE(buffer, INDEX_SIZE + 1);
+    buffer += BATCH_HEADER_SIZE;
+    len -= BATCH_HEADER_SIZE;
+
+    if (node_count == 0 || node_count > MAX_BATCH_NODES ||
+        body_length == 0 || body_length > MAX_TX_SIZE ||
+        (size_t)node_count * BATCH_NODE_SIZE + body_length < len) {
+        PRINTF("%s: wrong node count or transaction length\n", __func__);
+        THROW(EXCEPTION_MALFORMED_APDU);
+    }
+
+    tx_stream_t body_stream;
+    tx_stream_init(&body_stream, INS_SIGN_TRANSACTION_BATCH, buffer, len,
+                   !(p2 & P2_MORE), NULL, 0);
+
+    // Node list
+    pb_istream_t stream =
+        tx_stream_istream(&body_stream, node_count * BATCH_NODE_SIZE);
+    for (uint8_t i = 0; i < node_count; i++) {
+        uint8_t node[BATCH_NODE_SIZE];
+        if (!pb_read(&stream, node, sizeof(node))) {
+            batch_reset();
+            THROW(EXCEPTION_MALFORMED_APDU);
+        }
+        batch_ctx.nodes[i].shard = read_node_number(node, 0);
+        batch_ctx.nodes[i].realm = read_node_number(node, 8);
+        batch_ctx.nodes[i].account = read_node_number(node, 16);
+        if (batch_ctx.nodes[i].shard < 0 || batch_ctx.nodes[i].realm < 0 ||
+            batch_ctx.nodes[i].account < 0) {
+            batch_reset();
+            THROW(EXCEPTION_MALFORMED_APDU);
+        }
+    }
+    batch_ctx.node_count = node_count;
+
+    // Body, kept to re-encode it for every node
+    tx_stream_set_body(&body_stream, st_ctx.raw_transaction,
+                       sizeof(st_ctx.raw_transaction));
+    stream = tx_stream_istream(&body_stream, body_length);
+    capture_account_memo();
+    if (!Hedera_TransactionBody_decode(&stream, &st_ctx.transaction) ||
+        !tx_stream_finished(&body_stream)) {
+        PRINTF("%s: decoding failure\n", __func__);
+        batch_reset();
+        THROW(EXCEPTION_MALFORMED_APDU);
+    }
+    st_ctx.raw_transaction_length = body_stream.body_length;
+
+    size_t node_field_offset = 0;
+    size_t node_field_length = 0;
+    if (!find_unique_field(st_ctx.raw_transaction,
+                           st_ctx.raw_transaction_length,
+                           Hedera_TransactionBody_nodeAccountID_tag,
+                           &node_field_offset, &node_field_length)) {
+        PRINTF("%s: no single nodeAccountID\n", __func__);
+        batch_reset();
+        THROW(EXCEPTION_MALFORMED_APDU);
+    }
+    batch_ctx.node_field_offset = node_field_offset;
+    batch_ctx.node_field_length = node_field_length;
+
+    // Signed for the first node once approved
+    batch_ctx.next_node = 0;
+    st_ctx.reviewed_body = ReviewedBatch;
+
+    handle_transaction_body();
+
+    // Reviewed once, the body stays until every signature has been sent
+    batch_ctx.state = BATCH_REVIEW;
+}
+
+// Sign for the next node of an approved batch
+static void handle_batch_next(void) {
+    size_t signature_length = 0;
+
+    if (batch_ctx.state != BATCH_APPROVED ||
+        batch_ctx.next_node >= batch_ctx.node_count) {
+        PRINTF("%s: no approved batch\n", __func__);
+        batch_reset();
+        THROW(EXCEPTION_MALFORMED_APDU);
+    }
+
+    if (!batch_sign_next(G_io_apdu_buffer, &signature_length)) {
+        PRINTF("%s: signature failure\n", __func__);
+        MEMCLEAR(G_io_apdu_buffer);
+        batch_reset();
+        THROW(EXCEPTION_MALFORMED_APDU);
+    }
+
+    if (batch_ctx.next_node == batch_ctx.node_count) {
+        batch_reset();
+    }
+
+    io_exchange_with_code(EXCEPTION_OK, signature_length);
+}
+
+// Batch Sign Handler
+// Reviews one body once and signs it for several nodes: the bodies Hedera
+// SDKs build for each candidate node only differ by nodeAccountID.
+//
+// P1_BATCH_START, optionally split across APDUs with the P2 flags of
+// tx_stream.h:
+//   index (4, LE) | node count (1) | body length (2, LE) |
+//   nodes (count * 24: shard, realm, account as 8 bytes LE) | body
+// The body must contain nodeAccountID (field 2) exactly once; for each node
+// that field is replaced in place by its canonical encoding.
+// The approval answers with the signature for the first node, each
+// following P1_BATCH_NEXT request with the signature for the next one.
+void handle_sign_transaction_batch(uint8_t p1, uint8_t p2, uint8_t* buffer,
+                                   uint16_t len,
+                                   /* out */ volatile unsigned int* flags,
+                                   /* out */ volatile unsigned int* tx) {
+    UNUSED(tx);
+
+    switch (p1) {
+        case P1_BATCH_START:
+            drop_pending_requests();
+
+            handle_batch_start(p2, buffer, len);
+            break;
+
+        case P1_BATCH_NEXT:
+            handle_batch_next();
+            break;
+
+        default:
+            THROW(EXCEPTION_MALFORMED_APDU);
+    }
+
+    *flags |= IO_ASYNCH_REPLY;
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "app_globals.h"
+
+// P1 of INS_SIGN_TRANSACTION_BATCH
+#define P1_BATCH_START 0x00 // Body and node list, reviewed once
+#define P1_BATCH_NEXT 0x01  // Signature for the next node, once approved
+
+// Hedera SDKs build one body per candidate node, usually 3 to 10
+#define MAX_BATCH_NODES 10
+
+// Node account ID: shard, realm, account (8 bytes each, LE)
+#define BATCH_NODE_SIZE 24
+
+// index (4, LE) | node count (1) | body length (2, LE)
+#define BATCH_HEADER_SIZE (INDEX_SIZE + 1 + 2)
+
+typedef enum {
+    BATCH_NONE = 0,
+    BATCH_REVIEW,   // Waiting for the user
+    BATCH_APPROVED, // Remaining signatures may be requested
+} batch_state_t;
+
+typedef struct batch_node_s {
+    int64_t shard;
+    int64_t realm;
+    int64_t account;
+} batch_node_t;
+
+typedef struct batch_context_s {
+    batch_state_t state;
+
+    batch_node_t nodes[MAX_BATCH_NODES];
+    uint8_t node_count;
+    uint8_t next_node;
+
+    // nodeAccountID field (tag included) in st_ctx.raw_transaction
+    uint16_t node_field_offset;
+    uint16_t node_field_length;
+} batch_context_t;
+
+extern batch_context_t batch_ctx;
+
+// Drop any batch in progress along with its body
+void batch_reset(void);
+
+// User approved the review; the first signature has been sent
+void batch_approved(void);
+
+// Sign the kept body for the next node of the batch
+bool batch_sign_next(/* out */ uint8_t* result, /* out */ size_t* sig_len_out);
@@ -0,0 +1,227 @@
+#include "sign_transaction_queue.h"
+
+#include <string.h>
+
+#include "sign_transaction.h"
+#include "tx_stream.h"
+
+queue_context_t queue_ctx;
+
+void queue_reset(void) {
+    MEMCLEAR(queue_ctx);
+}
+
+// Decode the next body from the queue, starting at entry first, and review
+// it; the bodies were validated when added
+static bool queue_review_from(uint8_t first) {
+    for (queue_ctx.current = first; queue_ctx.current < queue_ctx.entry_count;
+         queue_ctx.current++) {
+        const queue_entry_t* entry = &queue_ctx.entries[queue_ctx.current];
+
+        memcpy(st_ctx.raw_transaction, queue_ctx.pool + entry->offset,
+               entry->length);
+        st_ctx.raw_transaction_length = entry->length;
+
+        pb_istream_t stream =
+            pb_istream_from_buffer(st_ctx.raw_transaction, entry->length);
+        capture_account_memo();
+        if (!Hedera_TransactionBody_decode(&stream, &st_ctx.transaction)) {
+            PRINTF("%s: decoding failure\n", __func__);
+            continue;
+        }
+
+        st_ctx.key_index = entry->key_index;
+        st_ctx.reviewed_body = ReviewedQueue;
+
+        handle_transaction_body();
+        return true;
+    }
+
+    return false;
+}
+
+bool queue_answer(bool approved) {
+    if (queue_ctx.state != QUEUE_REVIEW) {
+        return false;
+    }
+
+    queue_ctx.entries[queue_ctx.current].approved = approved;
+    MEMCLEAR(st_ctx.raw_transaction);
+
+    // Chain to the next review without waiting for the host
+    if (queue_review_from(queue_ctx.current + 1)) {
+        return true;
+    }
+
+    queue_ctx.state = QUEUE_ANSWERED;
+    st_ctx.reviewed_body = ReviewedNone;
+
+    // One byte per queued body: 1 if approved, 0 if rejected
+    for (uint8_t i = 0; i < queue_ctx.entry_count; i++) {
+        G_io_apdu_buffer[i] = queue_ctx.entries[i].approved;
+    }
+    io_exchange_with_code(EXCEPTION_OK, queue_ctx.entry_count);
+
+    return false;
+}
+
+// Decode and validate a body, then keep it for the review
+static void handle_queue_add(uint8_t p2, uint8_t* buffer, uint16_t len) {
+    if (buffer == NULL || len <= INDEX_SIZE) {
+        PRINTF("%s: wrong buffer pointer or input length\n", __func__);
+        THROW(EXCEPTION_MALFORMED_APDU);
+    }
+
+    // A continuation chunk without a preceding first chunk
+    if (p2 & P2_EXTEND) {
+        PRINTF("%s: unexpected continuation chunk\n", __func__);
+        THROW(EXCEPTION_MALFORMED_APDU);
+    }
+
+#ifdef HAVE_SWAP
+    // Exchange reviews a single transaction
+    if (G_called_from_swap) {
+        THROW(EXCEPTION_MALFORMED_APDU);
+    }
+#endif
+
+    // The first body starts a new queue
+    if (queue_ctx.state != QUEUE_FILLING) {
+        drop_pending_requests();
+        queue_ctx.state = QUEUE_FILLING;
+    }
+
+    if (queue_ctx.entry_count == MAX_QUEUE_ENTRIES) {
+        PRINTF("%s: queue full\n", __func__);
+        THROW(EXCEPTION_MALFORMED_APDU);
+    }
+
+    // Key Index (Little Endian format)
+    st_ctx.key_index = U4LE(buffer, 0);
+    buffer += INDEX_SIZE;
+    len -= INDEX_SIZE;
+
+    decode_raw_transaction(INS_SIGN_TRANSACTION_QUEUE, p2, p2 & P2_MORE,
+                           buffer, len);
+
+    // Refused bodies never reach the queue
+    format_transaction_body();
+
+    if (st_ctx.raw_transaction_length >
+        sizeof(queue_ctx.pool) - queue_ctx.pool_length) {
+        PRINTF("%s: queue full\n", __func__);
+        MEMCLEAR(st_ctx.raw_transaction);
+        THROW(EXCEPTION_MALFORMED_APDU);
+    }
+
+    queue_entry_t* entry = &queue_ctx.entries[queue_ctx.entry_count];
+    entry->key_index = st_ctx.key_index;
+    entry->offset = queue_ctx.pool_length;
+    entry->length = st_ctx.raw_transaction_length;
+    memcpy(queue_ctx.pool + entry->offset, st_ctx.raw_transaction,
+           entry->length);
+    queue_ctx.pool_length += entry->length;
+    MEMCLEAR(st_ctx.raw_transaction);
+
+    // Position of the body in the queue
+    G_io_apdu_buffer[0] = queue_ctx.entry_count++;
+    io_exchange_with_code(EXCEPTION_OK, 1);
+}
+
+// Review every queued body, the answer comes once all of them are answered
+static void handle_queue_review(void) {
+    if (queue_ctx.state != QUEUE_FILLING || queue_ctx.entry_count == 0) {
+        PRINTF("%s: empty queue\n", __func__);
+        queue_reset();
+        THROW(EXCEPTION_MALFORMED_APDU);
+    }
+
+    queue_ctx.state = QUEUE_REVIEW;
+    if (!queue_review_from(0)) {
+        queue_reset();
+        THROW(EXCEPTION_MALFORMED_APDU);
+    }
+}
+
+// Whether an approved body still waits for its signature
+static bool queue_has_unsigned(void) {
+    for (uint8_t i = 0; i < queue_ctx.entry_count; i++) {
+        if (queue_ctx.entries[i].approved && !queue_ctx.entries[i].signed_out) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Sign an approved body of the queue, once
+static void handle_queue_signature(uint8_t* buffer, uint16_t len) {
+    size_t signature_length = 0;
+
+    if (buffer == NULL || len != 1 || queue_ctx.state != QUEUE_ANSWERED ||
+        buffer[0] >= queue_ctx.entry_count ||
+        queue_ctx.entries[buffer[0]].signed_out) {
+        PRINTF("%s: no answered body\n", __func__);
+        THROW(EXCEPTION_MALFORMED_APDU);
+    }
+
+    queue_entry_t* entry = &queue_ctx.entries[buffer[0]];
+    if (!entry->approved) {
+        THROW(EXCEPTION_USER_REJECTED);
+    }
+
+    if (!hedera_sign(entry->key_index, queue_ctx.pool + entry->offset,
+                     entry->length, G_io_apdu_buffer, &signature_length)) {
+        PRINTF("%s: signature failure\n", __func__);
+        MEMCLEAR(G_io_apdu_buffer);
+        THROW(EXCEPTION_MALFORMED_APDU);
+    }
+
+    explicit_bzero(queue_ctx.pool + entry->offset, entry->length);
+    entry->signed_out = true;
+
+    // Nothing left to sign: the approvals go with the queue
+    if (!queue_has_unsigned()) {
+        queue_reset();
+    }
+
+    io_exchange_with_code(EXCEPTION_OK, signature_length);
+}
+
+// Queue Sign Handler
+// Reviews several transactions back to back, e.g. a payout list, without a
+// host round trip between two reviews.
+//
+// P1_QUEUE_ADD, optionally split across APDUs with the P2 flags of
+// tx_stream.h, answered with the position of the body in the queue:
+//   index (4, LE) | body                              (single APDU)
+//   index (4, LE) | body length (2, LE) | body...     (chunked)
+// P1_QUEUE_REVIEW starts the reviews and is answered once the last body has
+// been approved or rejected, with one byte per body (1 approved, 0 rejected).
+// P1_QUEUE_SIGNATURE, with the position of an approved body (1 byte), is
+// answered with its signature. Each body is signed once, and the queue is
+// dropped after the signature of the last approved one.
+void handle_sign_transaction_queue(uint8_t p1, uint8_t p2, uint8_t* buffer,
+                                   uint16_t len,
+                                   /* out */ volatile unsigned int* flags,
+                                   /* out */ volatile unsigned int* tx) {
+    UNUSED(tx);
+
+    switch (p1) {
+        case P1_QUEUE_ADD:
+            handle_queue_add(p2, buffer, len);
+            break;
+
+        case P1_QUEUE_REVIEW:
+            handle_queue_review();
+            break;
+
+        case P1_QUEUE_SIGNATURE:
+            handle_queue_signature(buffer, len);
+            break;
+
+        default:
+            THROW(EXCEPTION_MALFORMED_APDU);
+    }
+
+    *flags |= IO_ASYNCH_REPLY;
+}
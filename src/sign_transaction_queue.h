@@ -0,0 +1,59 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "app_globals.h"
+
+// P1 of INS_SIGN_TRANSACTION_QUEUE
+#define P1_QUEUE_ADD 0x00       // Validate a body and append it to the queue
+#define P1_QUEUE_REVIEW 0x01    // Review every queued body back to back
+#define P1_QUEUE_SIGNATURE 0x02 // Signature of an approved body
+
+// Payout lists are made of small transfers, about 100 bytes each
+#define MAX_QUEUE_ENTRIES 8
+#define QUEUE_POOL_SIZE (2 * MAX_TX_SIZE)
+
+typedef enum {
+    QUEUE_NONE = 0,
+    QUEUE_FILLING,  // Bodies are being added
+    QUEUE_REVIEW,   // Waiting for the user
+    QUEUE_ANSWERED, // Signatures of approved bodies may be requested
+} queue_state_t;
+
+typedef struct queue_entry_s {
+    uint32_t key_index;
+
+    // Body in queue_ctx.pool
+    uint16_t offset;
+    uint16_t length;
+
+    bool approved;
+    // Signature sent, the body has been wiped
+    bool signed_out;
+} queue_entry_t;
+
+typedef struct queue_context_s {
+    queue_state_t state;
+
+    queue_entry_t entries[MAX_QUEUE_ENTRIES];
+    uint8_t entry_count;
+
+    // Entry under review
+    uint8_t current;
+
+    // Validated bodies, stored back to back
+    uint8_t pool[QUEUE_POOL_SIZE];
+    uint16_t pool_length;
+} queue_context_t;
+
+extern queue_context_t queue_ctx;
+
+// Drop the queue along with its bodies
+void queue_reset(void);
+
+// Record the answer for the body under review and start the next review.
+// Once every body has been answered, reply to P1_QUEUE_REVIEW and return
+// false.
+bool queue_answer(bool approved);
@@ -0,0 +1,264 @@
+#include "sign_transaction_template.h"
+
+#include <pb_common.h>
+#include <string.h>
+
+#include "sign_transaction.h"
+#include "tx_stream.h"
+
+template_context_t template_ctx;
+
+// Split a message into its top-level fields; every field number must be
+// unique
+static bool split_fields(const uint8_t* buffer, size_t size,
+                         /* out */ template_field_t* fields,
+                         /* out */ uint8_t* field_count) {
+    pb_istream_t stream = pb_istream_from_buffer(buffer, size);
+    uint8_t count = 0;
+
+    while (stream.bytes_left > 0) {
+        size_t offset = size - stream.bytes_left;
+        pb_wire_type_t wire_type;
+        uint32_t number;
+        bool eof;
+
+        if (count == MAX_TEMPLATE_FIELDS ||
+            !pb_decode_tag(&stream, &wire_type, &number, &eof) ||
+            !pb_skip_field(&stream, wire_type)) {
+            return false;
+        }
+
+        for (uint8_t i = 0; i < count; i++) {
+            if (fields[i].number == number) {
+                return false;
+            }
+        }
+
+        fields[count].number = number;
+        fields[count].offset = offset;
+        fields[count].length = size - stream.bytes_left - offset;
+        count++;
+    }
+
+    *field_count = count;
+    return true;
+}
+
+// Reset a decoded field so that decoding it again replaces it instead of
+// merging into it
+static void reset_field(Hedera_TransactionBody* transaction, uint32_t number) {
+    pb_field_iter_t iter;
+
+    // Unknown fields are skipped by the decoder as well
+    if (!pb_field_iter_begin(&iter, Hedera_TransactionBody_fields,
+                             transaction) ||
+        !pb_field_iter_find(&iter, number)) {
+        return;
+    }
+
+    // The decoder clears a oneof when another member is selected
+    if (PB_HTYPE(iter.type) == PB_HTYPE_ONEOF) {
+        if (*(pb_size_t*)iter.pSize == iter.tag) {
+            *(pb_size_t*)iter.pSize = 0;
+        }
+        return;
+    }
+
+    if (PB_HTYPE(iter.type) == PB_HTYPE_REPEATED) {
+        memset(iter.pData, 0, (size_t)iter.data_size * iter.array_size);
+        *(pb_size_t*)iter.pSize = 0;
+    } else {
+        memset(iter.pData, 0, iter.data_size);
+        if (iter.pSize != NULL) {
+            *(bool*)iter.pSize = false;
+        }
+    }
+}
+
+static bool is_oneof_member(uint32_t number) {
+    pb_field_iter_t iter;
+
+    return pb_field_iter_begin(&iter, Hedera_TransactionBody_fields,
+                               &template_ctx.transaction) &&
+           pb_field_iter_find(&iter, number) &&
+           PB_HTYPE(iter.type) == PB_HTYPE_ONEOF;
+}
+
+// Decode and keep the template, along with the position of its fields
+static void handle_template_set(uint8_t p2, uint8_t* buffer, uint16_t len) {
+    if (buffer == NULL || len == 0) {
+        PRINTF("%s: wrong buffer pointer or input length\n", __func__);
+        THROW(EXCEPTION_MALFORMED_APDU);
+    }
+
+    // A continuation chunk without a preceding first chunk
+    if (p2 & P2_EXTEND) {
+        PRINTF("%s: unexpected continuation chunk\n", __func__);
+        THROW(EXCEPTION_MALFORMED_APDU);
+    }
+
+    drop_pending_requests();
+    MEMCLEAR(template_ctx);
+
+    decode_raw_transaction(INS_SIGN_TRANSACTION_TEMPLATE, p2, p2 & P2_MORE,
+                           buffer, len);
+
+    // Replacing one member of the transaction oneof must not leave another
+    // one behind
+    uint8_t oneof_members = 0;
+    if (split_fields(st_ctx.raw_transaction, st_ctx.raw_transaction_length,
+                     template_ctx.fields, &template_ctx.field_count)) {
+        for (uint8_t i = 0; i < template_ctx.field_count; i++) {
+            oneof_members += is_oneof_member(template_ctx.fields[i].number);
+        }
+    }
+    if (template_ctx.field_count == 0 || oneof_members > 1) {
+        PRINTF("%s: unsupported template\n", __func__);
+        MEMCLEAR(template_ctx);
+        MEMCLEAR(st_ctx.raw_transaction);
+        THROW(EXCEPTION_MALFORMED_APDU);
+    }
+
+    memcpy(template_ctx.body, st_ctx.raw_transaction,
+           st_ctx.raw_transaction_length);
+    template_ctx.body_length = st_ctx.raw_transaction_length;
+    memcpy(&template_ctx.transaction, &st_ctx.transaction,
+           sizeof(template_ctx.transaction));
+    memcpy(template_ctx.account_memo, st_ctx.account_memo,
+           sizeof(template_ctx.account_memo));
+    template_ctx.registered = true;
+    MEMCLEAR(st_ctx.raw_transaction);
+
+    io_exchange_with_code(EXCEPTION_OK, 0);
+}
+
+// Rebuild the template with the delta fields, then review it
+static void handle_template_sign(uint8_t* buffer, uint16_t len) {
+    template_field_t delta[MAX_TEMPLATE_FIELDS];
+    uint8_t delta_count = 0;
+
+    if (buffer == NULL || len <= INDEX_SIZE) {
+        PRINTF("%s: wrong buffer pointer or input length\n", __func__);
+        THROW(EXCEPTION_MALFORMED_APDU);
+    }
+
+    if (!template_ctx.registered) {
+        PRINTF("%s: no template\n", __func__);
+        THROW(EXCEPTION_MALFORMED_APDU);
+    }
+
+#ifdef HAVE_SWAP
+    // Exchange sends the whole transaction
+    if (G_called_from_swap) {
+        THROW(EXCEPTION_MALFORMED_APDU);
+    }
+#endif
+
+    drop_pending_requests();
+
+    // Key Index (Little Endian format)
+    st_ctx.key_index = U4LE(buffer, 0);
+    buffer += INDEX_SIZE;
+    len -= INDEX_SIZE;
+
+    if (!split_fields(buffer, len, delta, &delta_count)) {
+        PRINTF("%s: malformed delta\n", __func__);
+        THROW(EXCEPTION_MALFORMED_APDU);
+    }
+
+    // Every delta field replaces the template field with the same number
+    uint8_t replaced = 0;
+    size_t length = 0;
+    for (uint8_t i = 0; i < template_ctx.field_count; i++) {
+        const uint8_t* field = template_ctx.body + template_ctx.fields[i].offset;
+        size_t field_length = template_ctx.fields[i].length;
+
+        for (uint8_t j = 0; j < delta_count; j++) {
+            if (delta[j].number == template_ctx.fields[i].number) {
+                field = buffer + delta[j].offset;
+                field_length = delta[j].length;
+                replaced++;
+                break;
+            }
+        }
+
+        if (field_length > sizeof(st_ctx.raw_transaction) - length) {
+            PRINTF("%s: wrong transaction length\n", __func__);
+            drop_reviewed_transaction();
+            THROW(EXCEPTION_MALFORMED_APDU);
+        }
+        memcpy(st_ctx.raw_transaction + length, field, field_length);
+        length += field_length;
+    }
+    st_ctx.raw_transaction_length = length;
+
+    if (replaced != delta_count) {
+        PRINTF("%s: field not in the template\n", __func__);
+        drop_reviewed_transaction();
+        THROW(EXCEPTION_MALFORMED_APDU);
+    }
+
+    // Only the replaced fields are decoded
+    memcpy(&st_ctx.transaction, &template_ctx.transaction,
+           sizeof(st_ctx.transaction));
+    for (uint8_t i = 0; i < delta_count; i++) {
+        reset_field(&st_ctx.transaction, delta[i].number);
+    }
+    // Replaced along with the data field only
+    memcpy(st_ctx.account_memo, template_ctx.account_memo,
+           sizeof(st_ctx.account_memo));
+    capture_account_memo();
+    pb_istream_t stream = pb_istream_from_buffer(buffer, len);
+    if (!pb_decode_ex(&stream, Hedera_TransactionBody_fields,
+                      &st_ctx.transaction, PB_DECODE_NOINIT)) {
+        PRINTF("%s: decoding failure\n", __func__);
+        drop_reviewed_transaction();
+        THROW(EXCEPTION_MALFORMED_APDU);
+    }
+
+    // Signed with this key once approved
+    st_ctx.key_indices[0] = st_ctx.key_index;
+    st_ctx.reviewed_body = ReviewedRaw;
+
+    handle_transaction_body();
+}
+
+// Template Sign Handler
+// Most requests repeat the payer, node, fee and memo of a previous one: the
+// host registers a template body once, then only sends the fields that
+// change.
+//
+// P1_TEMPLATE_SET, optionally split across APDUs with the P2 flags of
+// tx_stream.h:
+//   body                                              (single APDU)
+//   body length (2, LE) | body...                     (chunked)
+// Each top-level field number may appear once, along with a single member
+// of the transaction oneof. The template stays until another one replaces
+// it.
+// P1_TEMPLATE_SIGN:
+//   index (4, LE) | delta
+// The delta is a serialized TransactionBody holding the changed top-level
+// fields. Each of them replaces in place the template field with the same
+// number, which must exist; the result is reviewed and signed like
+// INS_SIGN_TRANSACTION.
+void handle_sign_transaction_template(uint8_t p1, uint8_t p2, uint8_t* buffer,
+                                      uint16_t len,
+                                      /* out */ volatile unsigned int* flags,
+                                      /* out */ volatile unsigned int* tx) {
+    UNUSED(tx);
+
+    switch (p1) {
+        case P1_TEMPLATE_SET:
+            handle_template_set(p2, buffer, len);
+            break;
+
+        case P1_TEMPLATE_SIGN:
+            handle_template_sign(buffer, len);
+            break;
+
+        default:
+            THROW(EXCEPTION_MALFORMED_APDU);
+    }
+
+    *flags |= IO_ASYNCH_REPLY;
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "app_globals.h"
+#include "transaction_body.pb.h"
+
+// P1 of INS_SIGN_TRANSACTION_TEMPLATE
+#define P1_TEMPLATE_SET 0x00  // Register the template body
+#define P1_TEMPLATE_SIGN 0x01 // Sign the template with some fields replaced
+
+// Top-level fields of a body: transactionID, nodeAccountID, fee, duration,
+// memo, data and a few spare ones
+#define MAX_TEMPLATE_FIELDS 12
+
+// Top-level field of a body, tag included
+typedef struct template_field_s {
+    uint32_t number;
+    uint16_t offset;
+    uint16_t length;
+} template_field_t;
+
+typedef struct template_context_s {
+    bool registered;
+
+    uint8_t body[MAX_TX_SIZE];
+    uint16_t body_length;
+
+    template_field_t fields[MAX_TEMPLATE_FIELDS];
+    uint8_t field_count;
+
+    // Decoded once, the sign requests only decode the fields they replace
+    Hedera_TransactionBody transaction;
+    // Its account memo, captured as st_ctx.account_memo during the decoding
+    char account_memo[100];
+} template_context_t;
+
+extern template_context_t template_ctx;
@@ -8,11 +8,9 @@
 
 static void derive_public_key(uint32_t index, uint8_t public_key[RAW_PUBKEY_SIZE],
                               uint8_t public_key_str[RAW_PUBKEY_SIZE]) {
-    hedera_get_pubkey(index, public_key);
- 
-    uint8_t buffer[RAW_PUBKEY_SIZE];
-    public_key_to_bytes(buffer, public_key);
-    bin2hex(public_key_str, buffer, KEY_SIZE);
+    hedera_get_public_key(index, public_key);
+
+    bin2hex(public_key_str, public_key, PUBKEY_LENGTH);
     public_key_str[KEY_SIZE] = '\0';
 }
 
@@ -14,7 +14,7 @@
 typedef struct swap_validated_s {
     bool initialized;
     uint64_t amount;
-    char recipient[ACCOUNT_ID_SIZE];
+    swap_account_id_t recipient;
     uint64_t fee;
 } swap_validated_t;
 
@@ -56,11 +56,9 @@ bool copy_transaction_parameters(create_transaction_parameters_t *params) {
     swap_validated_t swap_validated;
     memset(&swap_validated, 0, sizeof(swap_validated));
 
-    strlcpy(swap_validated.recipient,
-            params->destination_address,
-            sizeof(swap_validated.recipient));
-    if (swap_validated.recipient[sizeof(swap_validated.recipient) - 1] != '\0') {
-        PRINTF("Address copy error\n");
+    // Parsed once, compared with the decoded account ID
+    if (!swap_parse_account_id(params->destination_address, &swap_validated.recipient)) {
+        PRINTF("Invalid destination address\n");
         return false;
     }
 
@@ -82,36 +80,28 @@ bool copy_transaction_parameters(create_transaction_parameters_t *params) {
 }
 
 bool validate_swap_amount(uint64_t amount) {
-
     if (amount != G_swap_validated.amount) {
         PRINTF("Amount not equal\n");
-        return false;
-    }
-    char validated_amount_str[MAX_PRINTABLE_AMOUNT_SIZE];
-    if (print_token_amount(G_swap_validated.amount,HEDERA_SIGN,HEDERA_DECIMALS, validated_amount_str, sizeof(validated_amount_str)) != 0) {
-        PRINTF("Conversion failed\n");
-        return false;
-    }
-    char amount_str[MAX_PRINTABLE_AMOUNT_SIZE];
-    if (print_token_amount(amount, HEDERA_SIGN, HEDERA_DECIMALS, amount_str, sizeof(amount_str)) != 0) {
-        PRINTF("Conversion failed\n");
-        return false;
-    }
-
-    if (strcmp(amount_str, validated_amount_str) != 0) {
-        PRINTF("Amount requested in this transaction = %s\n", amount_str);
-        PRINTF("Amount validated in swap = %s\n", validated_amount_str);
+        PRINTF("Amount requested in this transaction = %d\n", (uint32_t) amount);
+        PRINTF("Amount validated in swap = %d\n", (uint32_t) G_swap_validated.amount);
         return false;
     }
     return true;
 }
 
+// Checks the decoded transfer against the validated amount, fee and
+// recipient, without formatting anything
 bool swap_check_validity() {
     if (!G_swap_validated.initialized) {
         PRINTF("Swap Validated data not initialized.\n");
         return false;
     }
 
+    if (st_ctx.transaction.which_data != Hedera_TransactionBody_cryptoTransfer_tag) {
+        PRINTF("Transaction is not a transfer.\n");
+        return false;
+    }
+
     const Hedera_TransferList *transfer_list = &st_ctx.transaction.data.cryptoTransfer.transfers;
     const Hedera_AccountAmount *swap_amount = find_outbound_account_amount(transfer_list->accountAmounts, transfer_list->accountAmounts_count);
     if (swap_amount == NULL) {
@@ -131,10 +121,13 @@ bool swap_check_validity() {
         return false;
     }
 
-    if (memcmp(st_ctx.recipients, G_swap_validated.recipient, sizeof(st_ctx.recipients)) != 0) {
+    // The account credited by the transfer
+    const Hedera_AccountID *recipient = &swap_amount->accountID;
+    if (recipient->which_account != Hedera_AccountID_accountNum_tag ||
+        (uint64_t) recipient->shardNum != G_swap_validated.recipient.shard ||
+        (uint64_t) recipient->realmNum != G_swap_validated.recipient.realm ||
+        (uint64_t) recipient->account.accountNum != G_swap_validated.recipient.num) {
         PRINTF("Recipient on Transaction is different from validated package.\n");
-        PRINTF("Recipient requested in the transaction: %.*H\n", FULL_ADDRESS_LENGTH, st_ctx.recipients);
-        PRINTF("Recipient validated in the swap: %.*H\n", FULL_ADDRESS_LENGTH, G_swap_validated.recipient);
         return false;
     }
 
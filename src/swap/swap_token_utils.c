@@ -1,4 +1,5 @@
 #include <limits.h>
+#include <stdint.h>
 #include <string.h>
 
 #include "../utils.h"
@@ -17,6 +18,51 @@ bool swap_str_to_u64(const uint8_t* src, size_t length, uint64_t* result) {
     return true;
 }
 
+// Parse a decimal number up to the next '.' or the end of the string
+static const char *parse_account_number(const char *src, uint64_t *result) {
+    uint64_t value = 0;
+    const char *start = src;
+
+    while (*src >= '0' && *src <= '9') {
+        uint64_t digit = *src - '0';
+        if (value > (INT64_MAX - digit) / 10) {
+            return NULL;
+        }
+        value = value * 10 + digit;
+        src++;
+    }
+
+    if (src == start) {
+        return NULL;
+    }
+    *result = value;
+    return src;
+}
+
+bool swap_parse_account_id(const char *src, swap_account_id_t *result) {
+    swap_account_id_t account_id;
+
+    if (src == NULL || result == NULL) {
+        return false;
+    }
+
+    src = parse_account_number(src, &account_id.shard);
+    if (src == NULL || *src++ != '.') {
+        return false;
+    }
+    src = parse_account_number(src, &account_id.realm);
+    if (src == NULL || *src++ != '.') {
+        return false;
+    }
+    src = parse_account_number(src, &account_id.num);
+    if (src == NULL || *src != '\0') {
+        return false;
+    }
+
+    *result = account_id;
+    return true;
+}
+
 int print_token_amount(uint64_t amount,
                        const char *const asset,
                        uint8_t decimals,
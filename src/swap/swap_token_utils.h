@@ -7,7 +7,17 @@
 #define HEDERA_SIGN "HBAR"
 #define HEDERA_DECIMALS 8
 
+// Account ID of an Exchange destination
+typedef struct swap_account_id_s {
+    uint64_t shard;
+    uint64_t realm;
+    uint64_t num;
+} swap_account_id_t;
+
 bool swap_str_to_u64(const uint8_t* src, size_t length, uint64_t* result);
 
 int print_token_amount(uint64_t amount, const char *asset, uint8_t decimals,
                        char *out, size_t out_length);
+
+// Parse a "shard.realm.num" account ID, each number fitting an int64
+bool swap_parse_account_id(const char *src, swap_account_id_t *result);
@@ -0,0 +1,118 @@
+#include "tx_stream.h"
+
+#include <string.h>
+
+#include "app_globals.h"
+#include "app_io.h"
+#include "utils.h"
+
+void tx_stream_init(tx_stream_t* ctx, uint8_t ins, const uint8_t* chunk,
+                    uint16_t chunk_length, bool last_chunk, uint8_t* body,
+                    uint16_t body_size) {
+    memset(ctx, 0, sizeof(*ctx));
+    ctx->ins = ins;
+    ctx->chunk = chunk;
+    ctx->chunk_length = chunk_length;
+    ctx->last_chunk = last_chunk;
+    ctx->body = body;
+    ctx->body_size = body_size;
+}
+
+void tx_stream_set_body(tx_stream_t* ctx, uint8_t* body, uint16_t body_size) {
+    ctx->body = body;
+    ctx->body_size = body_size;
+    ctx->body_length = 0;
+}
+
+void tx_stream_set_sink(tx_stream_t* ctx, tx_stream_sink_fn* sink,
+                        void* sink_ctx) {
+    ctx->sink = sink;
+    ctx->sink_ctx = sink_ctx;
+}
+
+// Acknowledge the current chunk and wait for the host to send the next one
+static bool tx_stream_next_chunk(tx_stream_t* ctx) {
+    if (ctx->last_chunk) {
+        // Host announced more bytes than it sent
+        return false;
+    }
+
+    U2BE_ENCODE(G_io_apdu_buffer, 0, EXCEPTION_OK);
+    unsigned short rx = io_exchange(CHANNEL_APDU, 2);
+
+    // no APDU received; trigger a reset
+    if (rx == 0) {
+        THROW(EXCEPTION_IO_RESET);
+    }
+
+    uint16_t cdata_offset = 0;
+    uint16_t lc = 0;
+    if (!apdu_parse_lc(G_io_apdu_buffer, rx, &cdata_offset, &lc) ||
+        G_io_apdu_buffer[OFFSET_CLA] != CLA ||
+        G_io_apdu_buffer[OFFSET_INS] != ctx->ins ||
+        !(G_io_apdu_buffer[OFFSET_P2] & P2_EXTEND)) {
+        PRINTF("%s: unexpected APDU in chunked request\n", __func__);
+        return false;
+    }
+
+    ctx->chunk = G_io_apdu_buffer + cdata_offset;
+    ctx->chunk_length = lc;
+    ctx->chunk_offset = 0;
+    ctx->last_chunk = !(G_io_apdu_buffer[OFFSET_P2] & P2_MORE);
+
+    return true;
+}
+
+static bool tx_stream_read(pb_istream_t* stream, pb_byte_t* buf,
+                           size_t count) {
+    tx_stream_t* ctx = (tx_stream_t*)stream->state;
+
+    while (count > 0) {
+        if (ctx->chunk_offset == ctx->chunk_length) {
+            if (!tx_stream_next_chunk(ctx)) {
+                return false;
+            }
+            continue;
+        }
+
+        size_t available = ctx->chunk_length - ctx->chunk_offset;
+        size_t n = (count < available) ? count : available;
+        const uint8_t* src = ctx->chunk + ctx->chunk_offset;
+
+        if (ctx->body != NULL) {
+            if (n > (size_t)(ctx->body_size - ctx->body_length)) {
+                return false;
+            }
+            memcpy(ctx->body + ctx->body_length, src, n);
+            ctx->body_length += n;
+        }
+
+        if (ctx->sink != NULL && !ctx->sink(ctx->sink_ctx, src, n)) {
+            return false;
+        }
+
+        if (buf != NULL) {
+            memcpy(buf, src, n);
+            buf += n;
+        }
+        count -= n;
+        ctx->chunk_offset += n;
+    }
+
+    return true;
+}
+
+pb_istream_t tx_stream_istream(tx_stream_t* ctx, size_t total_length) {
+    pb_istream_t stream = {&tx_stream_read, ctx, total_length};
+    return stream;
+}
+
+bool tx_stream_skip(tx_stream_t* ctx, size_t length) {
+    pb_istream_t stream = tx_stream_istream(ctx, length);
+    // Called directly: nanopb would copy skipped bytes through a scratch buffer
+    return tx_stream_read(&stream, NULL, length);
+}
+
+bool tx_stream_finished(const tx_stream_t* ctx) {
+    return ctx->last_chunk && ctx->chunk_offset == ctx->chunk_length;
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <pb.h>
+#include <pb_decode.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// P2 flags of chunked requests
+// First chunk:        P2_MORE            (or 0 when the body fits one APDU)
+// Following chunks:   P2_EXTEND|P2_MORE
+// Last chunk:         P2_EXTEND
+#define P2_EXTEND 0x01 // This APDU continues the previous one
+#define P2_MORE 0x02   // More APDUs will follow this one
+
+// Length prefix of the body in the first chunk of a chunked request
+#define BODY_LENGTH_SIZE 2
+
+// Two-pass requests are not bounded by MAX_TX_SIZE
+#define STREAM_BODY_LENGTH_SIZE 4
+
+// P1 of INS_SIGN_TRANSACTION_STREAM
+#define P1_FIRST_PASS 0x00
+#define P1_SECOND_PASS 0x01
+#define P1_ECDSA 0x02 // Single pass, secp256k1 over the Keccak-256 digest
+
+// Receives every consumed body byte, in order
+typedef bool tx_stream_sink_fn(void* sink_ctx, const uint8_t* data,
+                               size_t length);
+
+// Pull-mode reader over a body split across several APDUs.
+// Chunks are consumed straight from G_io_apdu_buffer; when the current one is
+// exhausted the next one is requested from the host with an intermediate
+// 0x9000 reply, so decoding progresses as the chunks arrive.
+typedef struct tx_stream_s {
+    // Instruction every continuation APDU must carry
+    uint8_t ins;
+
+    // Current chunk, pointing into G_io_apdu_buffer
+    const uint8_t* chunk;
+    uint16_t chunk_length;
+    uint16_t chunk_offset;
+    bool last_chunk;
+
+    // Every consumed byte is appended here (may be NULL)
+    uint8_t* body;
+    uint16_t body_size;
+    uint16_t body_length;
+
+    // Optional sink, e.g. to hash the body without keeping it
+    tx_stream_sink_fn* sink;
+    void* sink_ctx;
+} tx_stream_t;
+
+void tx_stream_init(tx_stream_t* ctx, uint8_t ins, const uint8_t* chunk,
+                    uint16_t chunk_length, bool last_chunk, uint8_t* body,
+                    uint16_t body_size);
+
+// Append the bytes consumed from now on to body
+void tx_stream_set_body(tx_stream_t* ctx, uint8_t* body, uint16_t body_size);
+
+void tx_stream_set_sink(tx_stream_t* ctx, tx_stream_sink_fn* sink,
+                        void* sink_ctx);
+
+// Build a nanopb input stream reading exactly total_length bytes from ctx
+pb_istream_t tx_stream_istream(tx_stream_t* ctx, size_t total_length);
+
+// Consume length bytes without decoding them; they only reach the sink
+bool tx_stream_skip(tx_stream_t* ctx, size_t length);
+
+// True once the last chunk announced by the host has been fully consumed
+bool tx_stream_finished(const tx_stream_t* ctx);
@@ -17,15 +17,14 @@
 #define MAX_MEMO_SIZE 200
 #define SIGNATURE_SIZE 32
 #define INDEX_SIZE 4
+#define MAX_SIGNING_KEYS 4 // 4 signatures + status word fit one response
 
 #define HBAR 100000000 // tinybar
 #define HBAR_BUF_SIZE 26
 
 #define PATH_ZERO 44 | 0x80000000
 #define PATH_ONE 3030 | 0x80000000
-#define PATH_TWO 0x80000000
-#define PATH_THREE 0x80000000
-#define PATH_FOUR index | 0x80000000
+#define PATH_HARDENED 0x80000000
 
 #define CLA 0xE0
 
@@ -39,6 +38,10 @@
 #define OFFSET_LC 4
 #define OFFSET_CDATA 5
 
+// ISO 7816 extended length: Lc is encoded as 00 hi lo
+#define OFFSET_LC_EXTENDED 5
+#define OFFSET_CDATA_EXTENDED 7
+
 // User IDs for BAGL Elements
 static const uint8_t LEFT_ICON_ID = 0x01;
 static const uint8_t RIGHT_ICON_ID = 0x02;
@@ -1,4 +1,6 @@
 #include "app_io.h"
+#include "hedera.h"
+#include "sign_transaction.h"
 #include "utils.h"
 #include "ux.h"
 
@@ -53,6 +55,10 @@ uint8_t io_event(uint8_t channel) {
             break;
 #endif // HAVE_NBGL
         case SEPROXYHAL_TAG_TICKER_EVENT:
+            if (os_global_pin_is_validated() != BOLOS_UX_OK) {
+                drop_session_on_lock();
+            }
+            hedera_cache_tick();
             UX_TICKER_EVENT(G_io_seproxyhal_spi_buffer, {});
             break;
         default:
@@ -1,4 +1,5 @@
 #include "glyphs.h"
+#include "hedera.h"
 #include "ui_common.h"
 #include "utils.h"
 #include "ux.h"
@@ -12,6 +13,12 @@
  * Defines the main menu and idle actions for the app
  */
 
+// Cached keys are wiped before leaving
+static void quit_app_callback(void) {
+    hedera_cache_reset();
+    os_sched_exit(-1);
+}
+
 #if defined(TARGET_NANOX) || defined(TARGET_NANOS2)
 
 UX_STEP_NOCB(ux_idle_flow_1_step, nn, {"Awaiting", "Commands"});
@@ -22,7 +29,7 @@ UX_STEP_NOCB(ux_idle_flow_2_step, bn,
                  APPVERSION,
              });
 
-UX_STEP_VALID(ux_idle_flow_3_step, pb, os_sched_exit(-1),
+UX_STEP_VALID(ux_idle_flow_3_step, pb, quit_app_callback(),
               {&C_icon_dashboard_x, "Exit"});
 
 UX_DEF(ux_idle_flow, &ux_idle_flow_1_step, &ux_idle_flow_2_step,
@@ -41,8 +48,6 @@ static const nbgl_contentInfoList_t infoList = {
     .infoContents = info_contents,
 };
 
-static void quit_app_callback(void) { os_sched_exit(-1); }
-
 static void ui_idle_nbgl(void) {
     nbgl_useCaseHomeAndSettings(APPNAME, &ICON_APP_HOME, NULL,
                                 INIT_HOME_PAGE, NULL, &infoList, NULL,
@@ -1,6 +1,8 @@
 #include "glyphs.h"
 #include "proto/crypto_create.pb.h"
 #include "sign_transaction.h"
+#include "sign_transaction_batch.h"
+#include "sign_transaction_queue.h"
 #include "ui_common.h"
 #include "ux.h"
 
@@ -26,7 +28,19 @@
 // Confirm Callback
 unsigned int io_seproxyhal_tx_approve(const bagl_element_t* e) {
     UNUSED(e);
-    io_exchange_with_code(EXCEPTION_OK, st_ctx.signature_length);
+    // The next queued body is reviewed right away
+    if (st_ctx.reviewed_body == ReviewedQueue) {
+        if (!queue_answer(true)) {
+            ui_idle();
+        }
+        return 0;
+    }
+    if (sign_reviewed_transaction()) {
+        io_exchange_with_code(EXCEPTION_OK, st_ctx.signature_length);
+        batch_approved();
+    } else {
+        io_exchange_with_code(EXCEPTION_INTERNAL, 0);
+    }
     ui_idle();
     return 0;
 }
@@ -34,7 +48,14 @@ unsigned int io_seproxyhal_tx_approve(const bagl_element_t* e) {
 // Reject Callback
 unsigned int io_seproxyhal_tx_reject(const bagl_element_t* e) {
     UNUSED(e);
+    if (st_ctx.reviewed_body == ReviewedQueue) {
+        if (!queue_answer(false)) {
+            ui_idle();
+        }
+        return 0;
+    }
     io_exchange_with_code(EXCEPTION_USER_REJECTED, 0);
+    drop_reviewed_transaction();
     ui_idle();
     return 0;
 }
@@ -98,6 +119,9 @@ UX_STEP_NOCB(collect_rewards_step, bnnn_paging,
 UX_STEP_NOCB(account_memo_step, bnnn_paging,
              {.title = "Account memo", .text = (char*)st_ctx.account_memo});
 
+UX_STEP_NOCB(new_key_step, bnnn_paging,
+             {.title = "New key", .text = (char*)st_ctx.new_key});
+
 UX_STEP_NOCB(senders_erc20_step, bnnn_paging,
     {.title = "From", .text = (char*)st_ctx.operator});
 
@@ -181,6 +205,14 @@ UX_DEF(ux_update_flow, &summary_step, &operator_step, &senders_step,
        &max_auto_token_assoc_step, &account_memo_step, &fee_step, &memo_step,
        &confirm_step, &reject_step);
 
+// Update Key UX Flow: signed with several keys, shows them and the new key
+UX_DEF(ux_update_key_flow, &summary_step, &key_index_step, &operator_step,
+       &senders_step, &recipients_step, &amount_step, &new_key_step,
+       &auto_renew_period_step, &expiration_time_step,
+       &receiver_sig_required_step, &max_auto_token_assoc_step,
+       &account_memo_step, &fee_step, &memo_step, &confirm_step,
+       &reject_step);
+
 // Stake UX Flow
 UX_DEF(ux_stake_flow, &summary_token_trans_step, &key_index_step,
        &operator_step, &amount_step, &recipients_step, &collect_rewards_step,
@@ -231,12 +263,27 @@ UX_DEF(ux_contract_call_known_token_flow, WARNING_STEP,
     } while (0)
 
 static void review_choice(bool confirm) {
+    // The next queued body is reviewed right away, the answer waits for the
+    // last one. Nothing is signed yet: the host asks for the signatures of
+    // the approved bodies afterwards.
+    if (st_ctx.reviewed_body == ReviewedQueue) {
+        if (!queue_answer(confirm)) {
+            nbgl_useCaseStatus("Transactions\nreviewed", true, ui_idle);
+        }
+        return;
+    }
+
     // Answer, display a status page and go back to main
-    if (confirm) {
+    if (confirm && sign_reviewed_transaction()) {
         io_exchange_with_code(EXCEPTION_OK, st_ctx.signature_length);
+        batch_approved();
         nbgl_useCaseReviewStatus(STATUS_TYPE_TRANSACTION_SIGNED, ui_idle);
+    } else if (confirm) {
+        io_exchange_with_code(EXCEPTION_INTERNAL, 0);
+        nbgl_useCaseReviewStatus(STATUS_TYPE_TRANSACTION_REJECTED, ui_idle);
     } else {
         io_exchange_with_code(EXCEPTION_USER_REJECTED, 0);
+        drop_reviewed_transaction();
         nbgl_useCaseReviewStatus(STATUS_TYPE_TRANSACTION_REJECTED, ui_idle);
     }
 }
@@ -257,8 +304,8 @@ static void create_transaction_flow(void) {
     snprintf(review_final_title, sizeof(review_final_title),
              "Sign transaction to\n%s", st_ctx.summary_line_1);
 
-    infos[index].item = "With key";
-    infos[index].value = st_ctx.summary_line_2;
+    infos[index].item = st_ctx.key_count > 1 ? "With keys" : "With key";
+    infos[index].value = st_ctx.key_index_str;
     ++index;
 
     switch (st_ctx.type) {
@@ -301,6 +348,7 @@ static void create_transaction_flow(void) {
                     ADD_INFO_IF_SET(st_ctx.senders, st_ctx.senders_title);
                     ADD_INFO_IF_SET(st_ctx.recipients, st_ctx.recipients_title);
                     ADD_INFO_IF_SET(st_ctx.amount, st_ctx.amount_title);
+                    ADD_INFO_IF_SET(st_ctx.new_key, "New key");
                     ADD_INFO_IF_SET(st_ctx.auto_renew_period,
                                     "Auto renew period");
                     ADD_INFO_IF_SET(st_ctx.expiration_time, "Account expires");
@@ -392,7 +440,11 @@ void ui_sign_transaction(void) {
                     ux_flow_init(0, ux_unstake_flow, NULL);
                     break;
                 default:
-                    ux_flow_init(0, ux_update_flow, NULL);
+                    if (st_ctx.transaction.data.cryptoUpdateAccount.has_key) {
+                        ux_flow_init(0, ux_update_key_flow, NULL);
+                    } else {
+                        ux_flow_init(0, ux_update_flow, NULL);
+                    }
                     break;
             }
             break;
@@ -22,3 +22,27 @@ void bin2hex(uint8_t *dst, uint8_t *data, uint64_t inlen) {
     }
     dst[2 * inlen] = '\0';
 }
+
+bool apdu_parse_lc(const uint8_t *apdu, uint16_t rx,
+                   /* out */ uint16_t *cdata_offset, /* out */ uint16_t *lc) {
+    if (apdu == NULL || rx < OFFSET_LC) {
+        return false;
+    }
+
+    if (rx == OFFSET_LC) {
+        // No Lc, no data
+        *cdata_offset = OFFSET_CDATA;
+        *lc = 0;
+        return true;
+    }
+
+    if (apdu[OFFSET_LC] == 0 && rx >= OFFSET_CDATA_EXTENDED) {
+        *cdata_offset = OFFSET_CDATA_EXTENDED;
+        *lc = U2BE(apdu, OFFSET_LC_EXTENDED);
+    } else {
+        *cdata_offset = OFFSET_CDATA;
+        *lc = apdu[OFFSET_LC];
+    }
+
+    return (uint32_t)*cdata_offset + *lc <= rx;
+}
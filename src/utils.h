@@ -1,6 +1,7 @@
 #pragma once
 
 #include <os.h>
+#include <stdbool.h>
 #include <stdint.h>
 #include "app_globals.h"
 
@@ -17,3 +18,8 @@
 void public_key_to_bytes(unsigned char *dst, uint8_t raw_pubkey[static RAW_PUBKEY_SIZE]);
 
 void bin2hex(uint8_t *dst, uint8_t *data, uint64_t inlen);
+
+// Parse the Lc field of a received APDU, either short (1 byte) or ISO 7816
+// extended (00 hi lo). Fails if the announced data exceeds the rx bytes.
+bool apdu_parse_lc(const uint8_t *apdu, uint16_t rx,
+                   /* out */ uint16_t *cdata_offset, /* out */ uint16_t *lc);
@@ -0,0 +1,125 @@
+#include <string.h>
+
+#include "sign_transaction.h"
+#include "sign_transaction_batch.h"
+#include "sign_transaction_queue.h"
+#include "tx_stream.h"
+
+// Response data, the status word and the APDU header fit the rest
+#define VALIDATE_RESPONSE_SIZE 250
+
+// Append a NUL-terminated value to the response, truncated to what is left
+static uint16_t append_value(uint16_t offset, const char* value) {
+    if (offset >= VALIDATE_RESPONSE_SIZE) {
+        return offset;
+    }
+
+    size_t length = strlen(value);
+    if (length > VALIDATE_RESPONSE_SIZE - offset - 1) {
+        length = VALIDATE_RESPONSE_SIZE - offset - 1;
+    }
+    memcpy(G_io_apdu_buffer + offset, value, length);
+    G_io_apdu_buffer[offset + length] = '\0';
+
+    return offset + length + 1;
+}
+
+// Validate Handler
+// Runs the decoding, validation and formatting of INS_SIGN_TRANSACTION
+// without signing nor displaying anything, so that hosts can screen
+// transactions against the device logic.
+//
+// Same request as INS_SIGN_TRANSACTION, chunks included. Answered with
+// 0x9000 and either:
+//   refusal reason (1, see refusal_reason_t)
+// or, when the transaction would be reviewed:
+//   REFUSAL_NONE (1) | type (1, enum TransactionType) | summary | operator |
+//   senders title | senders | recipients title | recipients | amount title |
+//   amount | fee | memo
+// each value being NUL-terminated, the last ones truncated if they do not
+// fit.
+// Requests in progress are left as they are: a queue may keep filling around
+// validations. The instruction is refused while a body waits for its review
+// or its signatures, or between the passes of a two-pass request, as their
+// state shares st_ctx with the decoding.
+void handle_validate_transaction(uint8_t p1, uint8_t p2, uint8_t* buffer,
+                                 uint16_t len,
+                                 /* out */ volatile unsigned int* flags,
+                                 /* out */ volatile unsigned int* tx) {
+    UNUSED(p1);
+    UNUSED(tx);
+
+    // Checking input parameters
+    if ((buffer == NULL) || (len <= INDEX_SIZE)) {
+        PRINTF("%s: wrong buffer pointer or input length\n", __func__);
+        THROW(EXCEPTION_MALFORMED_APDU);
+    }
+
+    // A continuation chunk without a preceding first chunk
+    if (p2 & P2_EXTEND) {
+        PRINTF("%s: unexpected continuation chunk\n", __func__);
+        THROW(EXCEPTION_MALFORMED_APDU);
+    }
+
+#ifdef HAVE_SWAP
+    if (G_called_from_swap) {
+        THROW(EXCEPTION_MALFORMED_APDU);
+    }
+#endif
+
+    if (st_ctx.reviewed_body != ReviewedNone || st_ctx.two_pass_pending ||
+        batch_ctx.state != BATCH_NONE || queue_ctx.state == QUEUE_REVIEW) {
+        PRINTF("%s: request in progress\n", __func__);
+        THROW(EXCEPTION_MALFORMED_APDU);
+    }
+
+    // Validated as a single-key request
+    st_ctx.key_count = 1;
+    st_ctx.refusal_reason = REFUSAL_NONE;
+
+    // Key Index (Little Endian format)
+    st_ctx.key_index = U4LE(buffer, 0);
+    buffer += INDEX_SIZE;
+    len -= INDEX_SIZE;
+
+    BEGIN_TRY {
+        TRY {
+            decode_raw_transaction(INS_VALIDATE_TRANSACTION, p2, p2 & P2_MORE,
+                                   buffer, len);
+            format_transaction_body();
+        }
+        CATCH(EXCEPTION_IO_RESET) { THROW(EXCEPTION_IO_RESET); }
+        CATCH_OTHER(e) {
+            UNUSED(e);
+            PRINTF("%s: refused with %04x\n", __func__, e);
+            if (st_ctx.refusal_reason == REFUSAL_NONE) {
+                st_ctx.refusal_reason = REFUSAL_DECODE;
+            }
+        }
+        FINALLY {
+            drop_reviewed_transaction();
+        }
+    }
+    END_TRY;
+
+    uint16_t length = 0;
+    G_io_apdu_buffer[length++] = st_ctx.refusal_reason;
+    if (st_ctx.refusal_reason == REFUSAL_NONE) {
+        G_io_apdu_buffer[length++] = st_ctx.type;
+        length = append_value(length, st_ctx.summary_line_1);
+        length = append_value(length, st_ctx.operator);
+        length = append_value(length, st_ctx.senders_title);
+        length = append_value(length, st_ctx.senders);
+        length = append_value(length, st_ctx.recipients_title);
+        length = append_value(length, st_ctx.recipients);
+        length = append_value(length, st_ctx.amount_title);
+        length = append_value(length, st_ctx.amount);
+        length = append_value(length, st_ctx.fee);
+        length = append_value(length, st_ctx.memo);
+    }
+    st_ctx.refusal_reason = REFUSAL_NONE;
+
+    io_exchange_with_code(EXCEPTION_OK, length);
+
+    *flags |= IO_ASYNCH_REPLY;
+}
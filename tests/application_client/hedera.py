@@ -1,8 +1,10 @@
-from typing import List, Generator, Dict
+from typing import List, Generator, Dict, Tuple
 from enum import IntEnum
 from contextlib import contextmanager
 from time import sleep
 from nacl.signing import VerifyKey
+from eth_keys import keys
+from eth_utils import keccak
 
 from ragger.backend.interface import BackendInterface, RAPDU
 from ragger.bip import pack_derivation_path
@@ -15,17 +17,49 @@ class INS(IntEnum):
     INS_GET_APP_CONFIGURATION   = 0x01
     INS_GET_PUBLIC_KEY          = 0x02
     INS_SIGN_TRANSACTION        = 0x04
+    INS_SIGN_TRANSACTION_STREAM = 0x05
+    INS_SIGN_TRANSACTION_BATCH  = 0x06
+    INS_SIGN_TRANSACTION_MULTI  = 0x07
+    INS_SIGN_TRANSACTION_QUEUE  = 0x08
+    INS_SIGN_TRANSACTION_TEMPLATE = 0x09
+    INS_VALIDATE_TRANSACTION    = 0x0A
+    INS_GET_PUBLIC_KEYS         = 0x0B
+    INS_GET_EVM_ADDRESSES       = 0x0C
 
 CLA = 0xE0
 
 P1_CONFIRM = 0x00
 P1_NON_CONFIRM = 0x01
 
+P1_KEYS_START = 0x00
+P1_KEYS_NEXT = 0x01
+
+P1_SIGNATURE = 0x00
+P1_SIGNATURE_AND_KEY = 0x02
+
 P2_EXTEND = 0x01
 P2_MORE = 0x02
+P2_KEEP_KEY = 0x04
+
+P1_FIRST_PASS = 0x00
+P1_SECOND_PASS = 0x01
+P1_ECDSA = 0x02
+
+P1_BATCH_START = 0x00
+P1_BATCH_NEXT = 0x01
+
+P1_QUEUE_ADD = 0x00
+P1_QUEUE_REVIEW = 0x01
+P1_QUEUE_SIGNATURE = 0x02
+
+P1_TEMPLATE_SET = 0x00
+P1_TEMPLATE_SIGN = 0x01
 
 
 PUBLIC_KEY_LENGTH = 32
+EVM_ADDRESS_LENGTH = 20
+
+SECP256K1_ORDER = 0xFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD0364141
 
 MAX_CHUNK_SIZE = 255
 
@@ -40,6 +74,22 @@ HEDERA_PACKED_DERIVATION_PATH_2    = pack_derivation_path("m/44'/3030'/0'/0'")
 # Public key for verification
 HEDERA_PUBLIC_KEY = "698f0bad5c0c043a5f09cdcbb4c48ddcf6fb2886fa006df26298003fd59dc7c9"
 
+class RefusalReason(IntEnum):
+    NONE = 0x00
+    DECODE = 0x01
+    UNSUPPORTED = 0x02
+    TOO_MANY_TRANSFERS = 0x03
+    MIXED_TRANSFER = 0x04
+    UNBALANCED_TRANSFER = 0x05
+    TOO_MANY_TOKENS = 0x06
+    BAD_DECIMALS = 0x07
+    MEMO_TOO_LONG = 0x08
+    ZERO_ACCOUNT = 0x09
+    KEY_UPDATE = 0x0A
+    UNSUPPORTED_SELECTOR = 0x0B
+    CONTRACT_CALL = 0x0C
+
+
 class ErrorType:
     EXCEPTION_USER_REJECTED = 0x6985
     EXCEPTION_MALFORMED_APDU = 0x6e00
@@ -59,6 +109,33 @@ class HederaClient:
         index_b = index.to_bytes(4, "little")
         return self._client.exchange(CLA, INS.INS_GET_PUBLIC_KEY, P1_NON_CONFIRM, 0, index_b)
 
+    def bulk_export(self, ins: int, value_size: int, start: int, count: int,
+                    account: int = None, change: int = 0) -> List[bytes]:
+        """
+        Export the values of indices start to start + count - 1, several per
+        response, from m/44'/3030'/account'/change' when account is set.
+        """
+        payload = start.to_bytes(4, "little") + count.to_bytes(4, "little")
+        if account is not None:
+            payload += account.to_bytes(4, "little") + change.to_bytes(4, "little")
+        data = self._client.exchange(CLA, ins, P1_KEYS_START, 0, payload).data
+        while len(data) < count * value_size:
+            data += self._client.exchange(CLA, ins, P1_KEYS_NEXT, 0, b"").data
+        return [data[i:i + value_size] for i in range(0, len(data), value_size)]
+
+    def get_public_keys(self, start: int, count: int, account: int = None, change: int = 0) -> List[bytes]:
+        return self.bulk_export(INS.INS_GET_PUBLIC_KEYS, PUBLIC_KEY_LENGTH, start, count, account, change)
+
+    def get_evm_addresses(self, start: int, count: int, account: int = None, change: int = 0) -> List[bytes]:
+        return self.bulk_export(INS.INS_GET_EVM_ADDRESSES, EVM_ADDRESS_LENGTH, start, count, account, change)
+
+    def exchange_extended(self, ins: int, p1: int, p2: int, data: bytes) -> RAPDU:
+        """
+        Send an APDU with an ISO 7816 extended length field (00 hi lo).
+        """
+        header = bytes([CLA, ins, p1, p2, 0x00]) + len(data).to_bytes(2, "big")
+        return self._client.exchange_raw(header + data)
+
     @contextmanager
     def get_public_key_confirm(self, index: int) -> Generator[None, None, None]:
         index_b = index.to_bytes(4, "little")
@@ -100,6 +177,26 @@ class HederaClient:
         except Exception:
             return False
 
+    @staticmethod
+    def verify_ecdsa_signature(public_key: bytes, transaction: bytes, signature: bytes) -> bool:
+        """
+        Verify a secp256k1 signature r || s of the Keccak-256 digest of a
+        transaction, against a compressed public key. s must be low.
+        """
+        r = int.from_bytes(signature[:32], "big")
+        s = int.from_bytes(signature[32:], "big")
+        if len(signature) != 64 or s > SECP256K1_ORDER // 2:
+            return False
+        digest = keccak(transaction)
+        for v in (0, 1):
+            try:
+                recovered = keys.Signature(vrs=(v, r, s)).recover_public_key_from_msg_hash(digest)
+            except Exception:
+                continue
+            if recovered.to_compressed_bytes() == public_key:
+                return True
+        return False
+
     def sign_transaction(self,
                          index: int,
                          operator_shard_num: int,
@@ -149,7 +246,9 @@ class HederaClient:
                               operator_account_num: int,
                               transaction_fee: int,
                               memo: str,
-                              conf: Dict) -> Generator[None, None, None]:
+                              conf: Dict,
+                              p1: int = P1_SIGNATURE,
+                              p2: int = 0) -> Generator[None, None, None]:
 
         transaction = hedera_transaction(operator_shard_num,
                                          operator_realm_num,
@@ -160,10 +259,229 @@ class HederaClient:
 
         payload = index.to_bytes(4, "little") + transaction
 
-        with self._client.exchange_async(CLA, INS.INS_SIGN_TRANSACTION, P1_CONFIRM, 0, payload):
+        with self._client.exchange_async(CLA, INS.INS_SIGN_TRANSACTION, p1, p2, payload):
+            sleep(0.5)
+            yield
+
+    @staticmethod
+    def sign_transaction_chunks(index: int,
+                                transaction: bytes,
+                                chunk_size: int = MAX_CHUNK_SIZE) -> List[Tuple[int, bytes]]:
+        """
+        Split a sign request into (p2, data) APDU chunks.
+
+        A body fitting a single APDU is sent as before (P2 = 0). Longer bodies
+        announce their total length in the first chunk, following chunks only
+        carry body bytes.
+        """
+        payload = index.to_bytes(4, "little") + transaction
+        if len(payload) <= chunk_size:
+            return [(0, payload)]
+
+        payload = index.to_bytes(4, "little") + len(transaction).to_bytes(2, "little") + transaction
+        return HederaClient.split_chunks(payload, chunk_size)
+
+    @staticmethod
+    def split_chunks(payload: bytes, chunk_size: int = MAX_CHUNK_SIZE) -> List[Tuple[int, bytes]]:
+        """
+        Split a payload into (p2, data) APDU chunks flagged with P2_EXTEND / P2_MORE.
+        """
+        chunks = [payload[i:i + chunk_size] for i in range(0, len(payload), chunk_size)]
+        result = []
+        for i, chunk in enumerate(chunks):
+            p2 = 0
+            if i > 0:
+                p2 |= P2_EXTEND
+            if i < len(chunks) - 1:
+                p2 |= P2_MORE
+            result.append((p2, chunk))
+        return result
+
+    @staticmethod
+    def sign_transaction_two_pass_chunks(index: int,
+                                         transaction: bytes,
+                                         second_pass: bytes = None,
+                                         chunk_size: int = MAX_CHUNK_SIZE) -> List[Tuple[int, int, bytes]]:
+        """
+        Split a two-pass sign request into (p1, p2, data) APDU chunks.
+
+        The first pass announces the index and the body length, the second
+        pass sends the same body again (or second_pass, to test mismatches).
+        """
+        if second_pass is None:
+            second_pass = transaction
+        first = index.to_bytes(4, "little") + len(transaction).to_bytes(4, "little") + transaction
+        return [(P1_FIRST_PASS, p2, chunk) for p2, chunk in HederaClient.split_chunks(first, chunk_size)] + \
+               [(P1_SECOND_PASS, p2, chunk) for p2, chunk in HederaClient.split_chunks(second_pass, chunk_size)]
+
+    @contextmanager
+    def send_sign_transaction_chunked(self,
+                                      index: int,
+                                      transaction: bytes,
+                                      chunk_size: int = MAX_CHUNK_SIZE) -> Generator[None, None, None]:
+        chunks = self.sign_transaction_chunks(index, transaction, chunk_size)
+
+        for p2, chunk in chunks[:-1]:
+            response = self._client.exchange(CLA, INS.INS_SIGN_TRANSACTION, P1_CONFIRM, p2, chunk)
+            assert response.status == STATUS_OK
+
+        p2, chunk = chunks[-1]
+        with self._client.exchange_async(CLA, INS.INS_SIGN_TRANSACTION, P1_CONFIRM, p2, chunk):
             sleep(0.5)
             yield
 
+    @contextmanager
+    def send_sign_transaction_two_pass(self,
+                                       index: int,
+                                       transaction: bytes,
+                                       chunk_size: int = MAX_CHUNK_SIZE) -> Generator[None, None, None]:
+        chunks = self.sign_transaction_two_pass_chunks(index, transaction, chunk_size=chunk_size)
+
+        for p1, p2, chunk in chunks[:-1]:
+            response = self._client.exchange(CLA, INS.INS_SIGN_TRANSACTION_STREAM, p1, p2, chunk)
+            assert response.status == STATUS_OK
+
+        p1, p2, chunk = chunks[-1]
+        with self._client.exchange_async(CLA, INS.INS_SIGN_TRANSACTION_STREAM, p1, p2, chunk):
+            sleep(0.5)
+            yield
+
+    @contextmanager
+    def send_sign_transaction_ecdsa(self,
+                                    index: int,
+                                    transaction: bytes,
+                                    chunk_size: int = MAX_CHUNK_SIZE) -> Generator[None, None, None]:
+        payload = index.to_bytes(4, "little") + len(transaction).to_bytes(4, "little") + transaction
+        chunks = self.split_chunks(payload, chunk_size)
+
+        for p2, chunk in chunks[:-1]:
+            response = self._client.exchange(CLA, INS.INS_SIGN_TRANSACTION_STREAM, P1_ECDSA, p2, chunk)
+            assert response.status == STATUS_OK
+
+        p2, chunk = chunks[-1]
+        with self._client.exchange_async(CLA, INS.INS_SIGN_TRANSACTION_STREAM, P1_ECDSA, p2, chunk):
+            sleep(0.5)
+            yield
+
+    @staticmethod
+    def sign_transaction_batch_chunks(index: int,
+                                      transaction: bytes,
+                                      nodes: List[Tuple[int, int, int]],
+                                      chunk_size: int = MAX_CHUNK_SIZE) -> List[Tuple[int, bytes]]:
+        """
+        Split a batch sign request into (p2, data) APDU chunks.
+
+        nodes are (shard, realm, account) node account IDs, the body is signed
+        once per node with its nodeAccountID replaced.
+        """
+        payload = index.to_bytes(4, "little") + len(nodes).to_bytes(1, "little") + \
+            len(transaction).to_bytes(2, "little")
+        for node in nodes:
+            payload += b"".join(n.to_bytes(8, "little") for n in node)
+        return HederaClient.split_chunks(payload + transaction, chunk_size)
+
+    @contextmanager
+    def send_sign_transaction_batch(self,
+                                    index: int,
+                                    transaction: bytes,
+                                    nodes: List[Tuple[int, int, int]],
+                                    chunk_size: int = MAX_CHUNK_SIZE) -> Generator[None, None, None]:
+        chunks = self.sign_transaction_batch_chunks(index, transaction, nodes, chunk_size)
+
+        for p2, chunk in chunks[:-1]:
+            response = self._client.exchange(CLA, INS.INS_SIGN_TRANSACTION_BATCH, P1_BATCH_START, p2, chunk)
+            assert response.status == STATUS_OK
+
+        p2, chunk = chunks[-1]
+        with self._client.exchange_async(CLA, INS.INS_SIGN_TRANSACTION_BATCH, P1_BATCH_START, p2, chunk):
+            sleep(0.5)
+            yield
+
+    def sign_transaction_batch_next(self) -> RAPDU:
+        return self._client.exchange(CLA, INS.INS_SIGN_TRANSACTION_BATCH, P1_BATCH_NEXT, 0, b"")
+
+    @staticmethod
+    def sign_transaction_multi_chunks(indices: List[int],
+                                      transaction: bytes,
+                                      chunk_size: int = MAX_CHUNK_SIZE) -> List[Tuple[int, bytes]]:
+        """
+        Split a multi-key sign request into (p2, data) APDU chunks.
+        """
+        payload = len(indices).to_bytes(1, "little")
+        payload += b"".join(index.to_bytes(4, "little") for index in indices)
+        payload += len(transaction).to_bytes(2, "little")
+        return HederaClient.split_chunks(payload + transaction, chunk_size)
+
+    @contextmanager
+    def send_sign_transaction_multi(self,
+                                    indices: List[int],
+                                    transaction: bytes,
+                                    chunk_size: int = MAX_CHUNK_SIZE) -> Generator[None, None, None]:
+        chunks = self.sign_transaction_multi_chunks(indices, transaction, chunk_size)
+
+        for p2, chunk in chunks[:-1]:
+            response = self._client.exchange(CLA, INS.INS_SIGN_TRANSACTION_MULTI, 0, p2, chunk)
+            assert response.status == STATUS_OK
+
+        p2, chunk = chunks[-1]
+        with self._client.exchange_async(CLA, INS.INS_SIGN_TRANSACTION_MULTI, 0, p2, chunk):
+            sleep(0.5)
+            yield
+
+    def sign_transaction_queue_add(self, index: int, transaction: bytes) -> RAPDU:
+        """
+        Validate a transaction and append it to the review queue.
+        """
+        return self._client.exchange(CLA, INS.INS_SIGN_TRANSACTION_QUEUE, P1_QUEUE_ADD, 0,
+                                     index.to_bytes(4, "little") + transaction)
+
+    @contextmanager
+    def send_sign_transaction_queue_review(self) -> Generator[None, None, None]:
+        with self._client.exchange_async(CLA, INS.INS_SIGN_TRANSACTION_QUEUE, P1_QUEUE_REVIEW, 0, b""):
+            sleep(0.5)
+            yield
+
+    def sign_transaction_queue_signature(self, position: int) -> RAPDU:
+        return self._client.exchange(CLA, INS.INS_SIGN_TRANSACTION_QUEUE, P1_QUEUE_SIGNATURE, 0,
+                                     position.to_bytes(1, "little"))
+
+    def sign_transaction_template_set(self, transaction: bytes) -> RAPDU:
+        """
+        Register the template body later sign requests only send changes for.
+        """
+        payload = transaction
+        if len(transaction) > MAX_CHUNK_SIZE:
+            # Chunked bodies announce their length
+            payload = len(transaction).to_bytes(2, "little") + transaction
+        chunks = self.split_chunks(payload)
+        for p2, chunk in chunks[:-1]:
+            response = self._client.exchange(CLA, INS.INS_SIGN_TRANSACTION_TEMPLATE, P1_TEMPLATE_SET, p2, chunk)
+            assert response.status == STATUS_OK
+
+        p2, chunk = chunks[-1]
+        return self._client.exchange(CLA, INS.INS_SIGN_TRANSACTION_TEMPLATE, P1_TEMPLATE_SET, p2, chunk)
+
+    @contextmanager
+    def send_sign_transaction_template(self, index: int, delta: bytes) -> Generator[None, None, None]:
+        with self._client.exchange_async(CLA, INS.INS_SIGN_TRANSACTION_TEMPLATE, P1_TEMPLATE_SIGN, 0,
+                                         index.to_bytes(4, "little") + delta):
+            sleep(0.5)
+            yield
+
+    def validate_transaction(self, index: int, transaction: bytes) -> Tuple[int, List[str]]:
+        """
+        Run the device validation without signing.
+
+        :return: the refusal reason and, if none, the rendered values
+        """
+        response = self._client.exchange(CLA, INS.INS_VALIDATE_TRANSACTION, 0, 0,
+                                         index.to_bytes(4, "little") + transaction)
+        reason = response.data[0]
+        if reason != RefusalReason.NONE:
+            return reason, []
+        values = response.data[2:].split(b"\0")[:-1]
+        return reason, [response.data[1]] + [value.decode() for value in values]
+
     @contextmanager
     def send_sign_transaction_wrong_length(self,
                               len: int) -> bytes:
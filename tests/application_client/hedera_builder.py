@@ -43,6 +43,11 @@ def hedera_transaction(
     return transaction.SerializeToString()
 
 
+def hedera_transaction_delta(conf: Dict) -> bytes:
+    # Only the given top-level fields, to replace those of a template
+    return transaction_body_pb2.TransactionBody(**conf).SerializeToString()
+
+
 def crypto_create_account_conf(
     initialBalance: int,
     stakeTargetAccount: int = None,
@@ -83,6 +88,7 @@ def crypto_update_account_conf(
     receiverSigRequired: bool = None,
     maxAutoTokenAssociations: int = None,
     includeKey: bool = False,
+    newKey: bytes = None,
     accountMemo: str = None,
     stakeTargetShardNum: int = None,
     stakeTargetRealmNum: int = None,
@@ -100,6 +106,10 @@ def crypto_update_account_conf(
     if includeKey:
         dummy_key = basic_types_pb2.Key()
         crypto_update_account.key.CopyFrom(dummy_key)
+
+    # Replace the account key with an ed25519 key
+    if newKey is not None:
+        crypto_update_account.key.CopyFrom(basic_types_pb2.Key(ed25519=newKey))
     
     # Add decline rewards if specified
     if declineRewards is not None:
@@ -474,6 +484,21 @@ def token_mint_conf(
     return {"tokenMint": token_mint}
 
 
+def node_account_conf(
+    conf: Dict,
+    node_account_num: int,
+    node_shard_num: int = 0,
+    node_realm_num: int = 0,
+) -> Dict:
+    node_account = basic_types_pb2.AccountID(
+        shardNum=node_shard_num,
+        realmNum=node_realm_num,
+        accountNum=node_account_num,
+    )
+
+    return {"nodeAccountID": node_account, **conf}
+
+
 def contract_call_transaction(*args, **kwargs) -> bytes:
     """
     Deprecated: Transaction bodies are now built via hedera_transaction with contractCall oneof.
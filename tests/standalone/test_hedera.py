@@ -2,14 +2,18 @@ from ragger.backend.interface import RAPDU, RaisePolicy
 from ragger.navigator import NavInsID
 from ragger.firmware import Firmware
 from ragger.firmware.touch.use_cases import UseCaseReview
+from bip32 import BIP32
+from eth_keys import keys
+import hashlib
 import pytest
 
-from tests.application_client.hedera import HederaClient, ErrorType, STATUS_OK
+from tests.application_client.hedera import HederaClient, ErrorType, STATUS_OK, CLA, INS, P2_EXTEND, P1_SECOND_PASS, \
+    RefusalReason, P1_NON_CONFIRM, P1_SIGNATURE_AND_KEY, P2_KEEP_KEY
 from tests.application_client.hedera_builder import crypto_create_account_conf, crypto_transfer_verify, \
     crypto_transfer_invalid_amounts
 from tests.application_client.hedera_builder import crypto_update_account_conf
 from tests.application_client.hedera_builder import crypto_transfer_token_conf
-from tests.application_client.hedera_builder import crypto_transfer_hbar_conf
+from tests.application_client.hedera_builder import crypto_transfer_hbar_conf, node_account_conf, hedera_transaction_delta
 from tests.application_client.hedera_builder import crypto_transfer_simple_verify
 from tests.application_client.hedera_builder import token_associate_conf
 from tests.application_client.hedera_builder import token_dissociate_conf
@@ -26,6 +30,15 @@ from .utils import (ROOT_SCREENSHOT_PATH,
                     navigate_erc20_reject_at_warning, 
                     navigate_erc20_show_qr_code)
 
+# Seed of the default Speculos mnemonic, for keys the app does not export
+SPECULOS_SEED = hashlib.pbkdf2_hmac(
+    "sha512",
+    b"glory promote mansion idle axis finger extra february uncover one trip resource "
+    b"lawn turtle enact monster seven myth punch hobby comfort wild raise skin",
+    b"mnemonic",
+    2048,
+)
+
 
 def test_hedera_get_public_key_ok(backend, firmware, navigator, test_name):
     hedera = HederaClient(backend)
@@ -57,6 +70,98 @@ def test_hedera_get_public_key_ok(backend, firmware, navigator, test_name):
         assert from_public_key.hex() == key
 
 
+def test_hedera_get_public_key_extended_apdu(backend, firmware, navigator, test_name):
+    hedera = HederaClient(backend)
+    index = 11095
+    short_key = hedera.get_public_key_non_confirm(index).data
+    extended_key = hedera.exchange_extended(INS.INS_GET_PUBLIC_KEY, 1, 0, index.to_bytes(4, "little")).data
+    assert extended_key == short_key
+
+    # Announced length larger than the received data
+    backend.raise_policy = RaisePolicy.RAISE_NOTHING
+    rapdu = backend.exchange_raw(bytes([CLA, INS.INS_GET_PUBLIC_KEY, 1, 0, 0x00, 0x01, 0x00]) + index.to_bytes(4, "little"))
+    assert rapdu.status == ErrorType.EXCEPTION_MALFORMED_APDU
+
+
+def test_hedera_get_public_key_cached(backend, firmware, navigator, test_name):
+    hedera = HederaClient(backend)
+    expected = {
+        0: bytes.fromhex("78be747e6894ee5f965e3fb0e4c1628af2f9ae0d94dc01d9b9aab75484c3184b"),
+        11095: bytes.fromhex("644ef690d394e8140fa278273913425bc83c59067a392a9e7f703ead4973caf8"),
+    }
+
+    # More indices than cache entries, so that the first ones get evicted
+    indices = [0, 11095] + list(range(1, 10)) + [11095, 0]
+    keys = {}
+    for index in indices:
+        key = hedera.get_public_key_non_confirm(index).data
+        assert keys.setdefault(index, key) == key
+        if index in expected:
+            assert key == expected[index]
+
+    # Cached keys and derived keys agree
+    assert hedera.get_public_key_non_confirm(9).data == keys[9]
+    assert len(set(keys.values())) == len(keys)
+
+
+def test_hedera_get_public_keys(backend, firmware, navigator, test_name):
+    hedera = HederaClient(backend)
+
+    # Spans several responses
+    keys = hedera.get_public_keys(11090, 16)
+    assert len(keys) == 16
+    assert keys[5] == bytes.fromhex("644ef690d394e8140fa278273913425bc83c59067a392a9e7f703ead4973caf8")
+    for offset in (0, 7, 15):
+        assert keys[offset] == hedera.get_public_key_non_confirm(11090 + offset).data
+
+    # Other account and change levels
+    assert hedera.get_public_keys(11095, 1, account=0, change=0) == [keys[5]]
+    assert hedera.get_public_keys(0, 1, account=1) == \
+        [bytes.fromhex("83bc2ebae6949563da0f646a786788f19de0e7aa5deb35c77abeace4903d34f9")]
+
+    # The default parent node is derived again
+    assert hedera.get_public_key_non_confirm(11095).data == keys[5]
+
+    backend.raise_policy = RaisePolicy.RAISE_NOTHING
+
+    # The export is over
+    rapdu = backend.exchange(CLA, INS.INS_GET_PUBLIC_KEYS, 1, 0, b"")
+    assert rapdu.status == ErrorType.EXCEPTION_MALFORMED_APDU
+
+    # Empty, or wrapping around the last index
+    for start, count in ((0, 0), (0xFFFFFFFF, 2)):
+        payload = start.to_bytes(4, "little") + count.to_bytes(4, "little")
+        rapdu = backend.exchange(CLA, INS.INS_GET_PUBLIC_KEYS, 0, 0, payload)
+        assert rapdu.status == ErrorType.EXCEPTION_MALFORMED_APDU
+
+
+def test_hedera_get_evm_addresses(backend, firmware, navigator, test_name):
+    hedera = HederaClient(backend)
+    root = BIP32.from_seed(SPECULOS_SEED)
+
+    def evm_address(path: str) -> bytes:
+        public_key = keys.PublicKey.from_compressed_bytes(root.get_pubkey_from_path(path))
+        return public_key.to_canonical_address()
+
+    # Spans several responses
+    addresses = hedera.get_evm_addresses(40, 30)
+    assert len(addresses) == 30
+    for offset in (0, 11, 12, 29):
+        assert addresses[offset] == evm_address(f"m/44'/3030'/0'/0'/{40 + offset}'")
+
+    assert hedera.get_evm_addresses(3, 2, account=2, change=1) == \
+        [evm_address("m/44'/3030'/2'/1'/3'"), evm_address("m/44'/3030'/2'/1'/4'")]
+
+    # Both curves keep their own parent node
+    assert hedera.get_public_keys(11095, 1) == \
+        [bytes.fromhex("644ef690d394e8140fa278273913425bc83c59067a392a9e7f703ead4973caf8")]
+    assert hedera.get_evm_addresses(41, 1) == [addresses[1]]
+
+    backend.raise_policy = RaisePolicy.RAISE_NOTHING
+    rapdu = backend.exchange(CLA, INS.INS_GET_EVM_ADDRESSES, 1, 0, b"")
+    assert rapdu.status == ErrorType.EXCEPTION_MALFORMED_APDU
+
+
 def test_hedera_get_public_key_refused(backend, firmware, navigator, test_name):
     hedera = HederaClient(backend)
     with hedera.get_public_key_confirm(0):
@@ -1443,6 +1548,627 @@ def test_hedera_send_transaction_wrong_length(backend, firmware, scenario_naviga
     assert rapdu.status == ErrorType.EXCEPTION_MALFORMED_APDU
 
 
+def test_hedera_transfer_hbar_chunked_ok(backend, firmware, scenario_navigator):
+    hedera = HederaClient(backend)
+    key_index = 3
+    public_key = hedera.get_public_key_non_confirm(key_index).data
+    backend.wait_for_home_screen()
+
+    conf = crypto_transfer_hbar_conf(
+        sender_shardNum=57,
+        sender_realmNum=58,
+        sender_accountNum=59,
+        recipient_shardNum=100,
+        recipient_realmNum=101,
+        recipient_accountNum=102,
+        amount=1234567890,
+    )
+    transaction = hedera_transaction(
+        operator_shard_num=1,
+        operator_realm_num=2,
+        operator_account_num=3,
+        transaction_fee=5,
+        memo="m" * 100,
+        conf=conf,
+    )
+
+    # Force the body over several APDUs
+    with hedera.send_sign_transaction_chunked(key_index, transaction, chunk_size=64):
+        if firmware.is_nano:
+            scenario_navigator.review_approve(custom_screen_text="Confirm", do_comparison=False)
+        else:
+            scenario_navigator.review_approve(do_comparison=False)
+
+    signature = hedera.get_async_response().data
+    assert hedera.verify_signature(public_key, key_index.to_bytes(4, "little") + transaction, signature)
+
+
+def test_hedera_sign_transaction_orphan_chunk(backend, firmware, scenario_navigator):
+    hedera = HederaClient(backend)
+    backend.raise_policy = RaisePolicy.RAISE_NOTHING
+
+    # A continuation chunk without a first chunk is rejected
+    rapdu = backend.exchange(CLA, INS.INS_SIGN_TRANSACTION, 0, P2_EXTEND, bytes(16))
+    assert rapdu.status == ErrorType.EXCEPTION_MALFORMED_APDU
+
+
+def test_hedera_transfer_hbar_two_pass_ok(backend, firmware, scenario_navigator):
+    hedera = HederaClient(backend)
+    key_index = 7
+    public_key = hedera.get_public_key_non_confirm(key_index).data
+    backend.wait_for_home_screen()
+
+    conf = crypto_transfer_hbar_conf(
+        sender_shardNum=57,
+        sender_realmNum=58,
+        sender_accountNum=59,
+        recipient_shardNum=100,
+        recipient_realmNum=101,
+        recipient_accountNum=102,
+        amount=1234567890,
+    )
+    transaction = hedera_transaction(
+        operator_shard_num=1,
+        operator_realm_num=2,
+        operator_account_num=3,
+        transaction_fee=5,
+        memo="m" * 100,
+        conf=conf,
+    )
+
+    with hedera.send_sign_transaction_two_pass(key_index, transaction, chunk_size=64):
+        if firmware.is_nano:
+            scenario_navigator.review_approve(custom_screen_text="Confirm", do_comparison=False)
+        else:
+            scenario_navigator.review_approve(do_comparison=False)
+
+    signature = hedera.get_async_response().data
+    assert hedera.verify_signature(public_key, key_index.to_bytes(4, "little") + transaction, signature)
+
+
+def test_hedera_transfer_hbar_ecdsa_ok(backend, firmware, scenario_navigator):
+    hedera = HederaClient(backend)
+    key_index = 7
+
+    conf = crypto_transfer_hbar_conf(
+        sender_shardNum=57,
+        sender_realmNum=58,
+        sender_accountNum=59,
+        recipient_shardNum=100,
+        recipient_realmNum=101,
+        recipient_accountNum=102,
+        amount=1234567890,
+    )
+    # Larger than MAX_TX_SIZE, never held in RAM
+    transaction = hedera_transaction(
+        operator_shard_num=1,
+        operator_realm_num=2,
+        operator_account_num=3,
+        transaction_fee=5,
+        memo="m" * 100,
+        conf=conf,
+    ) + bytes([0xFA, 0x7F, 0x80, 0x04]) + bytes(512)
+
+    with hedera.send_sign_transaction_ecdsa(key_index, transaction, chunk_size=64):
+        if firmware.is_nano:
+            scenario_navigator.review_approve(custom_screen_text="Confirm", do_comparison=False)
+        else:
+            scenario_navigator.review_approve(do_comparison=False)
+
+    signature = hedera.get_async_response().data
+    public_key = BIP32.from_seed(SPECULOS_SEED).get_pubkey_from_path(f"m/44'/3030'/0'/0'/{key_index}'")
+    assert hedera.verify_ecdsa_signature(public_key, transaction, signature)
+
+
+def test_hedera_crypto_update_account_two_pass_ok(backend, firmware, scenario_navigator):
+    hedera = HederaClient(backend)
+    key_index = 7
+    public_key = hedera.get_public_key_non_confirm(key_index).data
+    backend.wait_for_home_screen()
+
+    # The account memo is read while decoding, the body is not kept
+    conf = crypto_update_account_conf(
+        targetShardNum=5,
+        targetRealmNum=10,
+        targetAccountNum=12345,
+        accountMemo="Nice Account Memo",
+    )
+    transaction = hedera_transaction(
+        operator_shard_num=1,
+        operator_realm_num=2,
+        operator_account_num=3,
+        transaction_fee=5,
+        memo="two_pass_update",
+        conf=conf,
+    )
+
+    with hedera.send_sign_transaction_two_pass(key_index, transaction, chunk_size=64):
+        if firmware.is_nano:
+            scenario_navigator.review_approve(custom_screen_text="Confirm", do_comparison=False)
+        else:
+            scenario_navigator.review_approve(do_comparison=False)
+
+    signature = hedera.get_async_response().data
+    assert hedera.verify_signature(public_key, key_index.to_bytes(4, "little") + transaction, signature)
+
+
+def test_hedera_sign_transaction_two_pass_mismatch(backend, firmware, scenario_navigator):
+    hedera = HederaClient(backend)
+    backend.raise_policy = RaisePolicy.RAISE_NOTHING
+
+    conf = crypto_transfer_hbar_conf(
+        sender_shardNum=57,
+        sender_realmNum=58,
+        sender_accountNum=59,
+        recipient_shardNum=100,
+        recipient_realmNum=101,
+        recipient_accountNum=102,
+        amount=1234567890,
+    )
+    transaction = hedera_transaction(1, 2, 3, 5, "first", conf)
+    tampered = hedera_transaction(1, 2, 3, 5, "other", conf)
+    assert len(tampered) == len(transaction)
+
+    # The second pass must carry the same body as the first one
+    chunks = hedera.sign_transaction_two_pass_chunks(0, transaction, second_pass=tampered, chunk_size=32)
+    for p1, p2, chunk in chunks[:-1]:
+        rapdu = backend.exchange(CLA, INS.INS_SIGN_TRANSACTION_STREAM, p1, p2, chunk)
+        assert rapdu.status == STATUS_OK
+    p1, p2, chunk = chunks[-1]
+    rapdu = backend.exchange(CLA, INS.INS_SIGN_TRANSACTION_STREAM, p1, p2, chunk)
+    assert rapdu.status == ErrorType.EXCEPTION_MALFORMED_APDU
+
+    # A second pass without a first one
+    rapdu = backend.exchange(CLA, INS.INS_SIGN_TRANSACTION_STREAM, P1_SECOND_PASS, 0, transaction)
+    assert rapdu.status == ErrorType.EXCEPTION_MALFORMED_APDU
+
+
+def test_hedera_transfer_hbar_batch_ok(backend, firmware, scenario_navigator):
+    hedera = HederaClient(backend)
+    key_index = 2
+    public_key = hedera.get_public_key_non_confirm(key_index).data
+    backend.wait_for_home_screen()
+
+    conf = crypto_transfer_hbar_conf(
+        sender_shardNum=57,
+        sender_realmNum=58,
+        sender_accountNum=59,
+        recipient_shardNum=100,
+        recipient_realmNum=101,
+        recipient_accountNum=102,
+        amount=1234567890,
+    )
+    nodes = [(0, 0, 3), (0, 0, 4), (0, 0, 300)]
+    bodies = [hedera_transaction(1, 2, 3, 5, "batch", node_account_conf(conf, node[2])) for node in nodes]
+
+    # Reviewed once for all the nodes
+    with hedera.send_sign_transaction_batch(key_index, bodies[0], nodes, chunk_size=64):
+        if firmware.is_nano:
+            scenario_navigator.review_approve(custom_screen_text="Confirm", do_comparison=False)
+        else:
+            scenario_navigator.review_approve(do_comparison=False)
+
+    signatures = [hedera.get_async_response().data]
+    for _ in nodes[1:]:
+        signatures.append(hedera.sign_transaction_batch_next().data)
+
+    for body, signature in zip(bodies, signatures):
+        assert hedera.verify_signature(public_key, key_index.to_bytes(4, "little") + body, signature)
+
+    # Every signature has been sent
+    backend.raise_policy = RaisePolicy.RAISE_NOTHING
+    rapdu = hedera.sign_transaction_batch_next()
+    assert rapdu.status == ErrorType.EXCEPTION_MALFORMED_APDU
+
+
+def test_hedera_sign_transaction_batch_without_node(backend, firmware, scenario_navigator):
+    hedera = HederaClient(backend)
+    backend.raise_policy = RaisePolicy.RAISE_NOTHING
+
+    conf = crypto_transfer_hbar_conf(
+        sender_shardNum=57,
+        sender_realmNum=58,
+        sender_accountNum=59,
+        recipient_shardNum=100,
+        recipient_realmNum=101,
+        recipient_accountNum=102,
+        amount=1234567890,
+    )
+    transaction = hedera_transaction(1, 2, 3, 5, "batch", conf)
+
+    # The body has no nodeAccountID to replace
+    (p2, chunk), = hedera.sign_transaction_batch_chunks(0, transaction, [(0, 0, 3)])
+    rapdu = backend.exchange(CLA, INS.INS_SIGN_TRANSACTION_BATCH, 0, p2, chunk)
+    assert rapdu.status == ErrorType.EXCEPTION_MALFORMED_APDU
+
+    # No approved batch
+    rapdu = hedera.sign_transaction_batch_next()
+    assert rapdu.status == ErrorType.EXCEPTION_MALFORMED_APDU
+
+
+def test_hedera_transfer_hbar_multi_key_ok(backend, firmware, scenario_navigator):
+    hedera = HederaClient(backend)
+    key_indices = [0, 1, 2]
+    public_keys = [hedera.get_public_key_non_confirm(index).data for index in key_indices]
+    backend.wait_for_home_screen()
+
+    conf = crypto_transfer_hbar_conf(
+        sender_shardNum=57,
+        sender_realmNum=58,
+        sender_accountNum=59,
+        recipient_shardNum=100,
+        recipient_realmNum=101,
+        recipient_accountNum=102,
+        amount=1234567890,
+    )
+    transaction = hedera_transaction(1, 2, 3, 5, "multi", conf)
+
+    with hedera.send_sign_transaction_multi(key_indices, transaction, chunk_size=64):
+        if firmware.is_nano:
+            scenario_navigator.review_approve(custom_screen_text="Confirm", do_comparison=False)
+        else:
+            scenario_navigator.review_approve(do_comparison=False)
+
+    signatures = hedera.get_async_response().data
+    assert len(signatures) == 64 * len(key_indices)
+    for i, public_key in enumerate(public_keys):
+        signature = signatures[64 * i:64 * (i + 1)]
+        assert hedera.verify_signature(public_key, bytes(4) + transaction, signature)
+
+
+def test_hedera_update_account_key_multi_key_ok(backend, firmware, scenario_navigator):
+    hedera = HederaClient(backend)
+    old_key = hedera.get_public_key_non_confirm(0).data
+    new_key = hedera.get_public_key_non_confirm(1).data
+    backend.wait_for_home_screen()
+
+    conf = crypto_update_account_conf(targetAccountNum=666, newKey=new_key)
+    transaction = hedera_transaction(1, 2, 3, 5, "rotate", conf)
+
+    # Both the old and the new key sign the rotation
+    with hedera.send_sign_transaction_multi([0, 1], transaction):
+        if firmware.is_nano:
+            scenario_navigator.review_approve(custom_screen_text="Confirm", do_comparison=False)
+        else:
+            scenario_navigator.review_approve(do_comparison=False)
+
+    signatures = hedera.get_async_response().data
+    assert hedera.verify_signature(old_key, bytes(4) + transaction, signatures[:64])
+    assert hedera.verify_signature(new_key, bytes(4) + transaction, signatures[64:])
+
+
+def test_hedera_update_account_key_single_key_refused(backend, firmware, scenario_navigator):
+    hedera = HederaClient(backend)
+    backend.raise_policy = RaisePolicy.RAISE_NOTHING
+
+    new_key = hedera.get_public_key_non_confirm(1).data
+    conf = crypto_update_account_conf(targetAccountNum=666, newKey=new_key)
+    transaction = hedera_transaction(1, 2, 3, 5, "rotate", conf)
+
+    # The new key must sign too
+    (p2, chunk), = hedera.sign_transaction_multi_chunks([0], transaction)
+    rapdu = backend.exchange(CLA, INS.INS_SIGN_TRANSACTION_MULTI, 0, p2, chunk)
+    assert rapdu.status == ErrorType.EXCEPTION_MALFORMED_APDU
+
+    # Too many keys for one response
+    (p2, chunk), = hedera.sign_transaction_multi_chunks([0, 1, 2, 3, 4], transaction)
+    rapdu = backend.exchange(CLA, INS.INS_SIGN_TRANSACTION_MULTI, 0, p2, chunk)
+    assert rapdu.status == ErrorType.EXCEPTION_MALFORMED_APDU
+
+
+def test_hedera_transfer_hbar_queue_ok(backend, firmware, scenario_navigator):
+    hedera = HederaClient(backend)
+    key_index = 0
+    public_key = hedera.get_public_key_non_confirm(key_index).data
+    backend.wait_for_home_screen()
+
+    transactions = []
+    for recipient in [102, 103, 104]:
+        conf = crypto_transfer_hbar_conf(
+            sender_shardNum=57,
+            sender_realmNum=58,
+            sender_accountNum=59,
+            recipient_shardNum=100,
+            recipient_realmNum=101,
+            recipient_accountNum=recipient,
+            amount=1234567890,
+        )
+        transactions.append(hedera_transaction(1, 2, 3, 5, "payout", conf))
+
+    for position, transaction in enumerate(transactions):
+        rapdu = hedera.sign_transaction_queue_add(key_index, transaction)
+        assert rapdu.data == bytes([position])
+
+    # Reviewed back to back, answered once the last one is approved
+    with hedera.send_sign_transaction_queue_review():
+        for _ in transactions:
+            if firmware.is_nano:
+                scenario_navigator.review_approve(custom_screen_text="Confirm", do_comparison=False)
+            else:
+                scenario_navigator.review_approve(do_comparison=False)
+
+    assert hedera.get_async_response().data == bytes([1] * len(transactions))
+
+    for position, transaction in enumerate(transactions):
+        signature = hedera.sign_transaction_queue_signature(position).data
+        assert hedera.verify_signature(public_key, bytes(4) + transaction, signature)
+
+
+def test_hedera_sign_transaction_queue_refused(backend, firmware, scenario_navigator):
+    hedera = HederaClient(backend)
+    backend.raise_policy = RaisePolicy.RAISE_NOTHING
+
+    # Nothing queued
+    rapdu = backend.exchange(CLA, INS.INS_SIGN_TRANSACTION_QUEUE, 1, 0, b"")
+    assert rapdu.status == ErrorType.EXCEPTION_MALFORMED_APDU
+
+    # Refused bodies never reach the queue
+    conf = crypto_update_account_conf(targetAccountNum=666, includeKey=True)
+    rapdu = hedera.sign_transaction_queue_add(0, hedera_transaction(1, 2, 3, 5, "payout", conf))
+    assert rapdu.status == ErrorType.EXCEPTION_MALFORMED_APDU
+
+    # Not reviewed
+    rapdu = hedera.sign_transaction_queue_signature(0)
+    assert rapdu.status == ErrorType.EXCEPTION_MALFORMED_APDU
+
+
+def test_hedera_transfer_hbar_template_ok(backend, firmware, scenario_navigator):
+    hedera = HederaClient(backend)
+    key_index = 0
+    public_key = hedera.get_public_key_non_confirm(key_index).data
+    backend.wait_for_home_screen()
+
+    def transfer_conf(recipient, amount):
+        return crypto_transfer_hbar_conf(
+            sender_shardNum=57,
+            sender_realmNum=58,
+            sender_accountNum=59,
+            recipient_shardNum=100,
+            recipient_realmNum=101,
+            recipient_accountNum=recipient,
+            amount=amount,
+        )
+
+    template = hedera_transaction(1, 2, 3, 5, "payroll", transfer_conf(102, 1))
+    assert hedera.sign_transaction_template_set(template).status == STATUS_OK
+
+    # Only the transfer changes, the payer, fee and memo come from the template
+    for recipient, amount in [(103, 1234567890), (104, 42)]:
+        conf = transfer_conf(recipient, amount)
+        delta = hedera_transaction_delta(conf)
+        transaction = hedera_transaction(1, 2, 3, 5, "payroll", conf)
+        assert len(delta) < len(transaction)
+
+        with hedera.send_sign_transaction_template(key_index, delta):
+            if firmware.is_nano:
+                scenario_navigator.review_approve(custom_screen_text="Confirm", do_comparison=False)
+            else:
+                scenario_navigator.review_approve(do_comparison=False)
+
+        signature = hedera.get_async_response().data
+        assert hedera.verify_signature(public_key, bytes(4) + transaction, signature)
+
+
+def test_hedera_sign_transaction_template_refused(backend, firmware, scenario_navigator):
+    hedera = HederaClient(backend)
+    backend.raise_policy = RaisePolicy.RAISE_NOTHING
+
+    conf = crypto_transfer_hbar_conf(
+        sender_shardNum=57,
+        sender_realmNum=58,
+        sender_accountNum=59,
+        recipient_shardNum=100,
+        recipient_realmNum=101,
+        recipient_accountNum=102,
+        amount=1,
+    )
+    template = hedera_transaction(1, 2, 3, 5, "payroll", conf)
+    assert hedera.sign_transaction_template_set(template).status == STATUS_OK
+
+    # The template has no node account to replace
+    delta = hedera_transaction_delta(node_account_conf({}, 3))
+    rapdu = backend.exchange(CLA, INS.INS_SIGN_TRANSACTION_TEMPLATE, 1, 0, bytes(4) + delta)
+    assert rapdu.status == ErrorType.EXCEPTION_MALFORMED_APDU
+
+
+def test_hedera_validate_transaction(backend, firmware):
+    hedera = HederaClient(backend)
+
+    conf = crypto_transfer_hbar_conf(
+        sender_shardNum=57,
+        sender_realmNum=58,
+        sender_accountNum=59,
+        recipient_shardNum=100,
+        recipient_realmNum=101,
+        recipient_accountNum=102,
+        amount=1234567890,
+    )
+    reason, values = hedera.validate_transaction(0, hedera_transaction(1, 2, 3, 5, "dry run", conf))
+    assert reason == RefusalReason.NONE
+    assert values[0] == 3  # Transfer
+    assert "100.101.102" in values
+    assert values[-1] == "dry run"
+
+    # Key updates need two keys
+    conf = crypto_update_account_conf(targetAccountNum=666, includeKey=True)
+    reason, _ = hedera.validate_transaction(0, hedera_transaction(1, 2, 3, 5, "", conf))
+    assert reason == RefusalReason.KEY_UPDATE
+
+    conf = crypto_update_account_conf(targetAccountNum=0)
+    reason, _ = hedera.validate_transaction(0, hedera_transaction(1, 2, 3, 5, "", conf))
+    assert reason == RefusalReason.ZERO_ACCOUNT
+
+    reason, _ = hedera.validate_transaction(0, b"\xff\xff\xff")
+    assert reason == RefusalReason.DECODE
+
+    # Nothing is left to approve
+    backend.wait_for_home_screen()
+
+
+def test_hedera_validate_transaction_during_queue_ok(backend, firmware, scenario_navigator):
+    hedera = HederaClient(backend)
+    key_index = 0
+    public_key = hedera.get_public_key_non_confirm(key_index).data
+    backend.wait_for_home_screen()
+
+    def transfer(recipient):
+        return crypto_transfer_hbar_conf(
+            sender_shardNum=57,
+            sender_realmNum=58,
+            sender_accountNum=59,
+            recipient_shardNum=100,
+            recipient_realmNum=101,
+            recipient_accountNum=recipient,
+            amount=1234567890,
+        )
+
+    queued = hedera_transaction(1, 2, 3, 5, "payout", transfer(102))
+    assert hedera.sign_transaction_queue_add(key_index, queued).data == bytes([0])
+
+    # Screening another body leaves the queue as it is
+    reason, values = hedera.validate_transaction(key_index, hedera_transaction(1, 2, 3, 5, "screened", transfer(103)))
+    assert reason == RefusalReason.NONE
+    assert "100.101.103" in values
+
+    second = hedera_transaction(1, 2, 3, 5, "payout", transfer(104))
+    assert hedera.sign_transaction_queue_add(key_index, second).data == bytes([1])
+
+    with hedera.send_sign_transaction_queue_review():
+        for _ in range(2):
+            if firmware.is_nano:
+                scenario_navigator.review_approve(custom_screen_text="Confirm", do_comparison=False)
+            else:
+                scenario_navigator.review_approve(do_comparison=False)
+
+    assert hedera.get_async_response().data == bytes([1, 1])
+
+    for position, transaction in enumerate([queued, second]):
+        signature = hedera.sign_transaction_queue_signature(position).data
+        assert hedera.verify_signature(public_key, bytes(4) + transaction, signature)
+
+
+def test_hedera_transfer_hbar_signature_and_key_ok(backend, firmware, scenario_navigator):
+    hedera = HederaClient(backend)
+    key_index = 3
+    public_key = hedera.get_public_key_non_confirm(key_index).data
+    backend.wait_for_home_screen()
+
+    conf = crypto_transfer_hbar_conf(
+        sender_shardNum=57,
+        sender_realmNum=58,
+        sender_accountNum=59,
+        recipient_shardNum=100,
+        recipient_realmNum=101,
+        recipient_accountNum=102,
+        amount=1234567890,
+    )
+
+    with hedera.send_sign_transaction(key_index, 1, 2, 3, 5, "with key", conf, p1=P1_SIGNATURE_AND_KEY):
+        if firmware.is_nano:
+            scenario_navigator.review_approve(custom_screen_text="Confirm", do_comparison=False)
+        else:
+            scenario_navigator.review_approve(do_comparison=False)
+
+    response = hedera.get_async_response().data
+    assert len(response) == 64 + 32
+    assert response[64:] == public_key
+    transaction = hedera_transaction(1, 2, 3, 5, "with key", conf)
+    assert hedera.verify_signature(public_key, bytes(4) + transaction, response[:64])
+
+
+def test_hedera_transfer_hbar_non_confirm_signature_only_ok(backend, firmware, scenario_navigator):
+    hedera = HederaClient(backend)
+    key_index = 3
+    public_key = hedera.get_public_key_non_confirm(key_index).data
+    backend.wait_for_home_screen()
+
+    conf = crypto_transfer_hbar_conf(
+        sender_shardNum=57,
+        sender_realmNum=58,
+        sender_accountNum=59,
+        recipient_shardNum=100,
+        recipient_realmNum=101,
+        recipient_accountNum=102,
+        amount=1234567890,
+    )
+
+    # P1_NON_CONFIRM, as sent by existing hosts, still gets the bare signature
+    with hedera.send_sign_transaction(key_index, 1, 2, 3, 5, "non confirm", conf, p1=P1_NON_CONFIRM):
+        if firmware.is_nano:
+            scenario_navigator.review_approve(custom_screen_text="Confirm", do_comparison=False)
+        else:
+            scenario_navigator.review_approve(do_comparison=False)
+
+    signature = hedera.get_async_response().data
+    assert len(signature) == 64
+    transaction = hedera_transaction(1, 2, 3, 5, "non confirm", conf)
+    assert hedera.verify_signature(public_key, bytes(4) + transaction, signature)
+
+
+def test_hedera_transfer_hbar_keep_key_ok(backend, firmware, scenario_navigator):
+    hedera = HederaClient(backend)
+    public_keys = {index: hedera.get_public_key_non_confirm(index).data for index in (3, 4)}
+    backend.wait_for_home_screen()
+
+    conf = crypto_transfer_hbar_conf(
+        sender_shardNum=57,
+        sender_realmNum=58,
+        sender_accountNum=59,
+        recipient_shardNum=100,
+        recipient_realmNum=101,
+        recipient_accountNum=102,
+        amount=1234567890,
+    )
+
+    # The kept key of index 3 must not sign for index 4
+    for key_index, memo in ((3, "first"), (3, "second"), (4, "third"), (3, "fourth")):
+        with hedera.send_sign_transaction(key_index, 1, 2, 3, 5, memo, conf, p2=P2_KEEP_KEY):
+            if firmware.is_nano:
+                scenario_navigator.review_approve(custom_screen_text="Confirm", do_comparison=False)
+            else:
+                scenario_navigator.review_approve(do_comparison=False)
+
+        signature = hedera.get_async_response().data
+        transaction = hedera_transaction(1, 2, 3, 5, memo, conf)
+        assert hedera.verify_signature(public_keys[key_index], bytes(4) + transaction, signature)
+        backend.wait_for_home_screen()
+
+
+def test_hedera_transfer_hbar_resent_ok(backend, firmware, scenario_navigator):
+    hedera = HederaClient(backend)
+    key_index = 5
+    public_key = hedera.get_public_key_non_confirm(key_index).data
+    backend.wait_for_home_screen()
+
+    conf = crypto_transfer_hbar_conf(
+        sender_shardNum=57,
+        sender_realmNum=58,
+        sender_accountNum=59,
+        recipient_shardNum=100,
+        recipient_realmNum=101,
+        recipient_accountNum=102,
+        amount=1234567890,
+    )
+
+    with hedera.send_sign_transaction(key_index, 1, 2, 3, 5, "resent", conf):
+        if firmware.is_nano:
+            scenario_navigator.review_approve(custom_screen_text="Confirm", do_comparison=False)
+        else:
+            scenario_navigator.review_approve(do_comparison=False)
+
+    signature = hedera.get_async_response().data
+    transaction = hedera_transaction(1, 2, 3, 5, "resent", conf)
+    assert hedera.verify_signature(public_key, bytes(4) + transaction, signature)
+    backend.wait_for_home_screen()
+
+    # The same body is answered without another review
+    payload = key_index.to_bytes(4, "little") + transaction
+    assert backend.exchange(CLA, INS.INS_SIGN_TRANSACTION, 0, 0, payload).data == signature
+    assert backend.exchange(CLA, INS.INS_SIGN_TRANSACTION, P1_SIGNATURE_AND_KEY, 0, payload).data == \
+        signature + public_key
+    assert backend.exchange(CLA, INS.INS_SIGN_TRANSACTION, P1_NON_CONFIRM, 0, payload).data == signature
+
+
 def test_hedera_erc20_transfer_good_signature_contract_id(backend, firmware, navigator, scenario_navigator, test_name):
     hedera = HederaClient(backend)
 
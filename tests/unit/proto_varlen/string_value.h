@@ -0,0 +1,42 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "proto_varlen_parser.h"
+
+// StringValue field of the cryptoUpdateAccount of a TransactionBody, resolved
+// with extract_fields on the path 15 / field_number / 1 and copied as a C
+// string: cut at output_size - 1 bytes or at the first NUL. The app reads
+// the account memo during the nanopb decode, the copy only serves the tests.
+static inline bool extract_string_value(const uint8_t *buffer,
+                                        size_t buffer_size,
+                                        uint32_t field_number, char *output,
+                                        size_t output_size) {
+    if (!buffer || !output || output_size == 0) {
+        return false;
+    }
+
+    memset(output, 0, output_size);
+
+    const protobuf_path_t path = {{15, field_number, 1}, 3};
+    protobuf_field_t value;
+    if (!extract_fields(buffer, buffer_size, &path, 1, &value) ||
+        value.data == NULL || value.wire_type != WIRE_TYPE_STRING) {
+        return false;
+    }
+
+    size_t copy_len = value.length;
+    if (copy_len >= output_size) {
+        copy_len = output_size - 1;
+    }
+    const uint8_t *nul = memchr(value.data, '\0', copy_len);
+    if (nul != NULL) {
+        copy_len = (size_t)(nul - value.data);
+    }
+
+    memcpy(output, value.data, copy_len);
+    return true;
+}
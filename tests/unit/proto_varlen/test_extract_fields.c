@@ -0,0 +1,239 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <string.h>
+#include <cmocka.h>
+
+// Include the module under test
+#include "proto_varlen_parser.h"
+
+// Test helper functions to create protobuf data
+static void write_varint(uint8_t **buffer, uint64_t value) {
+    while (value >= 0x80) {
+        **buffer = (uint8_t)(value | 0x80);
+        (*buffer)++;
+        value >>= 7;
+    }
+    **buffer = (uint8_t)value;
+    (*buffer)++;
+}
+
+static void write_varint_field(uint8_t **buffer, uint32_t field_number, uint64_t value) {
+    write_varint(buffer, (field_number << 3) | 0);
+    write_varint(buffer, value);
+}
+
+static void write_bytes_field(uint8_t **buffer, uint32_t field_number,
+                              const void *bytes, size_t length) {
+    write_varint(buffer, (field_number << 3) | 2);
+    write_varint(buffer, length);
+    memcpy(*buffer, bytes, length);
+    *buffer += length;
+}
+
+static void write_string_field(uint8_t **buffer, uint32_t field_number, const char *str) {
+    write_bytes_field(buffer, field_number, str, strlen(str));
+}
+
+// StringValue / Int32Value / BoolValue wrapper holding value
+static size_t write_string_value(uint8_t *buffer, const char *value) {
+    uint8_t *ptr = buffer;
+    write_string_field(&ptr, 1, value);
+    return (size_t)(ptr - buffer);
+}
+
+static size_t write_varint_value(uint8_t *buffer, uint64_t value) {
+    uint8_t *ptr = buffer;
+    write_varint_field(&ptr, 1, value);
+    return (size_t)(ptr - buffer);
+}
+
+static void assert_string_view(const protobuf_field_t *field, const char *expected) {
+    assert_non_null(field->data);
+    assert_int_equal(field->wire_type, WIRE_TYPE_STRING);
+    assert_int_equal(field->length, strlen(expected));
+    assert_memory_equal(field->data, expected, field->length);
+}
+
+// cryptoUpdateAccount with an account ID, a memo, a max token associations
+// and a decline reward, after a fee and a transaction memo
+static size_t write_crypto_update(uint8_t *buffer) {
+    uint8_t account[8];
+    uint8_t memo[32];
+    uint8_t associations[8];
+    uint8_t decline[8];
+    uint8_t update[96];
+    uint8_t *ptr = account;
+
+    write_varint_field(&ptr, 3, 1234);
+    size_t account_length = (size_t)(ptr - account);
+    size_t memo_length = write_string_value(memo, "account memo");
+    size_t associations_length = write_varint_value(associations, 10);
+    size_t decline_length = write_varint_value(decline, 1);
+
+    ptr = update;
+    write_bytes_field(&ptr, 2, account, account_length);
+    write_bytes_field(&ptr, 14, memo, memo_length);
+    write_bytes_field(&ptr, 15, associations, associations_length);
+    write_bytes_field(&ptr, 21, decline, decline_length);
+    size_t update_length = (size_t)(ptr - update);
+
+    ptr = buffer;
+    write_varint_field(&ptr, 3, 100000);
+    write_string_field(&ptr, 6, "memo");
+    write_bytes_field(&ptr, 15, update, update_length);
+    return (size_t)(ptr - buffer);
+}
+
+static void test_extract_fields_single_pass(void **state) {
+    (void) state; // unused
+
+    uint8_t buffer[128];
+    size_t length = write_crypto_update(buffer);
+
+    const protobuf_path_t paths[] = {
+        {{15, 14, 1}, 3}, // memo.value
+        {{15, 15, 1}, 3}, // max_automatic_token_associations.value
+        {{15, 21, 1}, 3}, // decline_reward.value
+        {{15, 2}, 2},     // accountIDToUpdate
+        {{3}, 1},         // transactionFee
+        {{6}, 1},         // memo
+        {{15, 14, 2}, 3}, // absent
+        {{11, 13}, 2},    // absent parent
+    };
+    protobuf_field_t fields[sizeof(paths) / sizeof(paths[0])];
+
+    assert_true(extract_fields(buffer, length, paths, sizeof(paths) / sizeof(paths[0]), fields));
+
+    assert_string_view(&fields[0], "account memo");
+
+    uint64_t value = 0;
+    assert_true(protobuf_field_varint(&fields[1], &value));
+    assert_int_equal(value, 10);
+    assert_true(protobuf_field_varint(&fields[2], &value));
+    assert_int_equal(value, 1);
+
+    // The account ID is a view on the submessage
+    assert_int_equal(fields[3].wire_type, WIRE_TYPE_STRING);
+    assert_int_equal(fields[3].field_number, 2);
+    const uint8_t account[] = {0x18, 0xD2, 0x09};
+    assert_int_equal(fields[3].length, sizeof(account));
+    assert_memory_equal(fields[3].data, account, sizeof(account));
+
+    assert_true(protobuf_field_varint(&fields[4], &value));
+    assert_int_equal(value, 100000);
+    assert_string_view(&fields[5], "memo");
+
+    assert_null(fields[6].data);
+    assert_null(fields[7].data);
+    assert_false(protobuf_field_varint(&fields[6], &value));
+
+    // Views into the buffer, nothing copied
+    for (size_t i = 0; i < 6; i++) {
+        assert_true(fields[i].data >= buffer);
+        assert_true(fields[i].data + fields[i].length <= buffer + length);
+    }
+}
+
+static void test_extract_fields_last_occurrence(void **state) {
+    (void) state; // unused
+
+    uint8_t first[16];
+    uint8_t second[16];
+    uint8_t memo[16];
+    uint8_t buffer[64];
+    uint8_t *ptr = first;
+
+    write_bytes_field(&ptr, 14, memo, write_string_value(memo, "first"));
+    size_t first_length = (size_t)(ptr - first);
+    ptr = second;
+    write_bytes_field(&ptr, 14, memo, write_string_value(memo, "second"));
+    size_t second_length = (size_t)(ptr - second);
+
+    // Two cryptoUpdateAccount, merged by the decoders
+    ptr = buffer;
+    write_bytes_field(&ptr, 15, first, first_length);
+    write_varint_field(&ptr, 3, 1);
+    write_bytes_field(&ptr, 15, second, second_length);
+    write_varint_field(&ptr, 3, 2);
+
+    const protobuf_path_t paths[] = {{{15, 14, 1}, 3}, {{3}, 1}};
+    protobuf_field_t fields[2];
+    assert_true(extract_fields(buffer, (size_t)(ptr - buffer), paths, 2, fields));
+    assert_string_view(&fields[0], "second");
+
+    uint64_t value = 0;
+    assert_true(protobuf_field_varint(&fields[1], &value));
+    assert_int_equal(value, 2);
+}
+
+static void test_extract_fields_fixed_width(void **state) {
+    (void) state; // unused
+
+    const uint8_t buffer[] = {
+        0x09, 1, 2, 3, 4, 5, 6, 7, 8, // Field 1, 64-bit
+        0x15, 9, 10, 11, 12,          // Field 2, 32-bit
+    };
+    const protobuf_path_t paths[] = {{{1}, 1}, {{2}, 1}};
+    protobuf_field_t fields[2];
+
+    assert_true(extract_fields(buffer, sizeof(buffer), paths, 2, fields));
+    assert_int_equal(fields[0].wire_type, WIRE_TYPE_64BIT);
+    assert_ptr_equal(fields[0].data, buffer + 1);
+    assert_int_equal(fields[0].length, 8);
+    assert_int_equal(fields[1].wire_type, WIRE_TYPE_32BIT);
+    assert_ptr_equal(fields[1].data, buffer + 10);
+    assert_int_equal(fields[1].length, 4);
+
+    uint64_t value = 0;
+    assert_false(protobuf_field_varint(&fields[0], &value));
+}
+
+static void test_extract_fields_malformed(void **state) {
+    (void) state; // unused
+
+    protobuf_field_t fields[PROTOBUF_MAX_PATHS + 1];
+    const protobuf_path_t memo = {{15, 14, 1}, 3};
+
+    // Inside a path, a field that is not a message
+    const uint8_t varint_parent[] = {0x78, 0x01};
+    assert_false(extract_fields(varint_parent, sizeof(varint_parent), &memo, 1, fields));
+
+    // Malformed after the field, still walked
+    const uint8_t trailing[] = {0x7A, 0x06, 0x72, 0x04, 0x0A, 0x02, 'h', 'i', 0x0F};
+    assert_false(extract_fields(trailing, sizeof(trailing), &memo, 1, fields));
+    assert_true(extract_fields(trailing, sizeof(trailing) - 1, &memo, 1, fields));
+    assert_string_view(&fields[0], "hi");
+
+    // Length past the end of the enclosing message
+    const uint8_t overlong[] = {0x7A, 0x04, 0x72, 0x05, 0x0A, 0x03};
+    assert_false(extract_fields(overlong, sizeof(overlong), &memo, 1, fields));
+
+    // Invalid paths
+    const protobuf_path_t empty = {{0}, 0};
+    const protobuf_path_t too_deep = {{1, 1, 1, 1}, PROTOBUF_PATH_MAX_DEPTH + 1};
+    protobuf_path_t too_many[PROTOBUF_MAX_PATHS + 1];
+    for (size_t i = 0; i < PROTOBUF_MAX_PATHS + 1; i++) {
+        too_many[i] = memo;
+    }
+    assert_false(extract_fields(trailing, 8, &empty, 1, fields));
+    assert_false(extract_fields(trailing, 8, &too_deep, 1, fields));
+    assert_false(extract_fields(trailing, 8, too_many, PROTOBUF_MAX_PATHS + 1, fields));
+    assert_true(extract_fields(trailing, 8, too_many, PROTOBUF_MAX_PATHS, fields));
+    assert_false(extract_fields(trailing, 8, &memo, 0, fields));
+    assert_false(extract_fields(NULL, 8, &memo, 1, fields));
+    assert_false(extract_fields(trailing, 8, NULL, 1, fields));
+    assert_false(extract_fields(trailing, 8, &memo, 1, NULL));
+}
+
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_extract_fields_single_pass),
+        cmocka_unit_test(test_extract_fields_last_occurrence),
+        cmocka_unit_test(test_extract_fields_fixed_width),
+        cmocka_unit_test(test_extract_fields_malformed),
+    };
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,103 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <string.h>
+#include <cmocka.h>
+
+// Include the module under test
+#include "proto_varlen_parser.h"
+
+// Test helper functions to create protobuf data
+static void write_varint(uint8_t **buffer, uint64_t value) {
+    while (value >= 0x80) {
+        **buffer = (uint8_t)(value | 0x80);
+        (*buffer)++;
+        value >>= 7;
+    }
+    **buffer = (uint8_t)value;
+    (*buffer)++;
+}
+
+static void write_string_field(uint8_t **buffer, uint32_t field_number, const char *str) {
+    write_varint(buffer, (field_number << 3) | 2);
+    size_t len = strlen(str);
+    write_varint(buffer, len);
+    memcpy(*buffer, str, len);
+    *buffer += len;
+}
+
+static void write_submessage_field(uint8_t **buffer, uint32_t field_number,
+                                   const uint8_t *submessage, size_t submessage_len) {
+    write_varint(buffer, (field_number << 3) | 2);
+    write_varint(buffer, submessage_len);
+    memcpy(*buffer, submessage, submessage_len);
+    *buffer += submessage_len;
+}
+
+// Test data: malformed protobuf
+static const uint8_t malformed_proto[] = {
+    0x7A, 0xFF,                    // Field 15, invalid length
+    'T', 'e', 's', 't'             // Truncated data
+};
+
+// Test cases for find_unique_field
+
+static void test_find_unique_field_valid(void **state) {
+    (void) state; // unused
+
+    uint8_t buffer[64];
+    uint8_t *ptr = buffer;
+    const uint8_t node[] = {0x18, 0x03};  // accountNum = 3
+
+    write_varint(&ptr, (1 << 3) | 0);      // Field 1, varint
+    write_varint(&ptr, 300);
+    write_submessage_field(&ptr, 2, node, sizeof(node));
+    write_string_field(&ptr, 6, "memo");
+
+    size_t offset = 0;
+    size_t length = 0;
+    assert_true(find_unique_field(buffer, (size_t)(ptr - buffer), 2, &offset, &length));
+    assert_int_equal(offset, 3);
+    assert_int_equal(length, 4);
+    assert_memory_equal(buffer + offset + 2, node, sizeof(node));
+}
+
+static void test_find_unique_field_absent_or_repeated(void **state) {
+    (void) state; // unused
+
+    uint8_t buffer[64];
+    uint8_t *ptr = buffer;
+    size_t offset = 0;
+    size_t length = 0;
+
+    write_string_field(&ptr, 6, "memo");
+    assert_false(find_unique_field(buffer, (size_t)(ptr - buffer), 2, &offset, &length));
+
+    // Protobuf keeps the last occurrence; refuse to guess
+    write_string_field(&ptr, 2, "a");
+    write_string_field(&ptr, 2, "b");
+    assert_false(find_unique_field(buffer, (size_t)(ptr - buffer), 2, &offset, &length));
+}
+
+static void test_find_unique_field_malformed(void **state) {
+    (void) state; // unused
+
+    size_t offset = 0;
+    size_t length = 0;
+    assert_false(find_unique_field(malformed_proto, sizeof(malformed_proto), 15, &offset, &length));
+
+    // Target field with a varint wire type
+    const uint8_t varint_field[] = {0x10, 0x01};
+    assert_false(find_unique_field(varint_field, sizeof(varint_field), 2, &offset, &length));
+}
+
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_find_unique_field_valid),
+        cmocka_unit_test(test_find_unique_field_absent_or_repeated),
+        cmocka_unit_test(test_find_unique_field_malformed),
+    };
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
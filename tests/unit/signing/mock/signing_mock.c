@@ -0,0 +1,168 @@
+#include "signing_mock.h"
+
+#include <string.h>
+
+#include "hedera.h"
+#include "sign_transaction.h"
+
+uint8_t G_io_apdu_buffer[IO_APDU_BUFFER_SIZE];
+
+jmp_buf signing_mock_throw;
+unsigned int signing_mock_exception;
+
+unsigned int signing_mock_reviews;
+
+unsigned int signing_mock_cache_resets;
+
+uint16_t signing_mock_reply_code;
+uint16_t signing_mock_reply_length;
+
+void THROW(unsigned int exception) {
+    signing_mock_exception = exception;
+    longjmp(signing_mock_throw, 1);
+}
+
+void io_exchange_with_code(uint16_t code, uint16_t tx) {
+    signing_mock_reply_code = code;
+    signing_mock_reply_length = tx;
+}
+
+// Only chunked bodies wait for the next APDU, the tests send single ones
+unsigned short io_exchange(unsigned char channel, unsigned short tx_len) {
+    (void)channel;
+    (void)tx_len;
+    return 0;
+}
+
+void ui_sign_transaction(void) {
+    signing_mock_reviews++;
+}
+
+bool hedera_get_public_key(uint32_t index,
+                           uint8_t pubkey[static PUBKEY_LENGTH]) {
+    (void)index;
+    memset(pubkey, 0, PUBKEY_LENGTH);
+    return true;
+}
+
+void hedera_cache_reset(void) {
+    signing_mock_cache_resets++;
+}
+
+// Fixed signature, the tests only follow the requests
+bool hedera_sign(uint32_t index, const uint8_t *tx, size_t tx_len,
+                 uint8_t *result, size_t *sig_len_out) {
+    (void)index;
+    (void)tx;
+    (void)tx_len;
+    memset(result, SIGNING_MOCK_SIGNATURE_BYTE, ED25519_SIGNATURE_SIZE);
+    if (sig_len_out) *sig_len_out = ED25519_SIGNATURE_SIZE;
+    return true;
+}
+
+void hedera_signature_cache_add(uint32_t index, const uint8_t *tx,
+                                size_t tx_len,
+                                const uint8_t signature[static ED25519_SIGNATURE_SIZE]) {
+    (void)index;
+    (void)tx;
+    (void)tx_len;
+    (void)signature;
+}
+
+bool hedera_signature_cache_find(uint32_t index, const uint8_t *tx,
+                                 size_t tx_len,
+                                 uint8_t signature[static ED25519_SIGNATURE_SIZE]) {
+    (void)index;
+    (void)tx;
+    (void)tx_len;
+    (void)signature;
+    return false;
+}
+
+// The other signatures are not sent by the tests
+
+bool hedera_sign_with_pubkey(uint32_t index, const uint8_t *tx, size_t tx_len,
+                             uint8_t *result, size_t *sig_len_out,
+                             uint8_t pubkey[static PUBKEY_LENGTH]) {
+    (void)index;
+    (void)tx;
+    (void)tx_len;
+    (void)result;
+    (void)sig_len_out;
+    (void)pubkey;
+    return false;
+}
+
+bool hedera_sign_keep_key(uint32_t index, const uint8_t *tx, size_t tx_len,
+                          uint8_t *result, size_t *sig_len_out) {
+    (void)index;
+    (void)tx;
+    (void)tx_len;
+    (void)result;
+    (void)sig_len_out;
+    return false;
+}
+
+bool hedera_sign_ecdsa(uint32_t index,
+                       const uint8_t digest[static SECP256K1_SCALAR_SIZE],
+                       uint8_t *result, size_t *sig_len_out) {
+    (void)index;
+    (void)digest;
+    (void)result;
+    (void)sig_len_out;
+    return false;
+}
+
+bool hedera_stream_sign_init(uint32_t index, hedera_stream_sign_t *ctx) {
+    (void)index;
+    (void)ctx;
+    return false;
+}
+
+bool hedera_stream_sign_update(hedera_stream_sign_t *ctx, const uint8_t *data,
+                               size_t data_len) {
+    (void)ctx;
+    (void)data;
+    (void)data_len;
+    return false;
+}
+
+bool hedera_stream_sign_nonce(hedera_stream_sign_t *ctx) {
+    (void)ctx;
+    return false;
+}
+
+bool hedera_stream_sign_final(uint32_t index, hedera_stream_sign_t *ctx,
+                              uint8_t *result, size_t *sig_len_out) {
+    (void)index;
+    (void)ctx;
+    (void)result;
+    (void)sig_len_out;
+    return false;
+}
+
+cx_err_t cx_sha256_init_no_throw(cx_sha256_t *hash) {
+    (void)hash;
+    return -1;
+}
+
+cx_err_t cx_keccak_init_no_throw(cx_sha3_t *hash, size_t size) {
+    (void)hash;
+    (void)size;
+    return -1;
+}
+
+cx_err_t cx_hash_no_throw(cx_hash_t *hash, uint32_t mode, const uint8_t *in,
+                          size_t len, uint8_t *out, size_t out_len) {
+    (void)hash;
+    (void)mode;
+    (void)in;
+    (void)len;
+    (void)out;
+    (void)out_len;
+    return -1;
+}
+
+void _putchar(char character) {
+    (void)character;
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <setjmp.h>
+#include <stdint.h>
+
+// THROW jumps back here with the exception, see signing_request in the tests
+extern jmp_buf signing_mock_throw;
+extern unsigned int signing_mock_exception;
+
+// Every byte of the signature returned by hedera_sign
+#define SIGNING_MOCK_SIGNATURE_BYTE 0x5A
+
+// Reviews started with ui_sign_transaction
+extern unsigned int signing_mock_reviews;
+
+// Calls to hedera_cache_reset
+extern unsigned int signing_mock_cache_resets;
+
+// Status word and length of the last reply sent with io_exchange_with_code
+extern uint16_t signing_mock_reply_code;
+extern uint16_t signing_mock_reply_length;
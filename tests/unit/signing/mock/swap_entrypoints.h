@@ -0,0 +1,3 @@
+#pragma once
+
+#include "swap_lib_calls.h"
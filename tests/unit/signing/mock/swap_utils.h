@@ -0,0 +1,4 @@
+#pragma once
+
+// Built without HAVE_SWAP
+#include "os.h"
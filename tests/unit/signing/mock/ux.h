@@ -0,0 +1,3 @@
+#pragma once
+
+// The reviews are answered by the tests, see signing_mock.c
@@ -0,0 +1,307 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <string.h>
+#include <cmocka.h>
+
+#include <pb_encode.h>
+
+#include "handlers.h"
+#include "sign_transaction.h"
+#include "sign_transaction_batch.h"
+#include "sign_transaction_queue.h"
+#include "signing_mock.h"
+#include "tx_stream.h"
+
+// Requests kept across APDUs (approved batches and queues), and their end on
+// a device lock. Speculos cannot lock the device: the tests call drop_session_on_lock
+// as the ticker of ui/io.c does while locked.
+
+#define TEST_KEY_INDEX 0
+#define TEST_NODE_COUNT 2
+#define TEST_QUEUE_LENGTH 2
+
+static uint8_t body[MAX_TX_SIZE];
+static size_t body_length;
+
+// Transfer of 1 HBAR from 0.0.1234 to 0.0.1235, for node 0.0.3
+static void encode_transfer_body(void) {
+    Hedera_TransactionBody transaction = Hedera_TransactionBody_init_zero;
+
+    transaction.has_transactionID = true;
+    transaction.transactionID.has_transactionValidStart = true;
+    transaction.transactionID.transactionValidStart.seconds = 1700000000;
+    transaction.transactionID.has_accountID = true;
+    transaction.transactionID.accountID.which_account =
+        Hedera_AccountID_accountNum_tag;
+    transaction.transactionID.accountID.account.accountNum = 1234;
+    transaction.has_nodeAccountID = true;
+    transaction.nodeAccountID.which_account = Hedera_AccountID_accountNum_tag;
+    transaction.nodeAccountID.account.accountNum = 3;
+    transaction.transactionFee = 100000;
+    transaction.has_transactionValidDuration = true;
+    transaction.transactionValidDuration.seconds = 120;
+
+    transaction.which_data = Hedera_TransactionBody_cryptoTransfer_tag;
+    Hedera_TransferList *transfers =
+        &transaction.data.cryptoTransfer.transfers;
+    transaction.data.cryptoTransfer.has_transfers = true;
+    transfers->accountAmounts_count = 2;
+    transfers->accountAmounts[0].has_accountID = true;
+    transfers->accountAmounts[0].accountID.which_account =
+        Hedera_AccountID_accountNum_tag;
+    transfers->accountAmounts[0].accountID.account.accountNum = 1234;
+    transfers->accountAmounts[0].amount = -100000000;
+    transfers->accountAmounts[1].has_accountID = true;
+    transfers->accountAmounts[1].accountID.which_account =
+        Hedera_AccountID_accountNum_tag;
+    transfers->accountAmounts[1].accountID.account.accountNum = 1235;
+    transfers->accountAmounts[1].amount = 100000000;
+
+    pb_ostream_t stream = pb_ostream_from_buffer(body, sizeof(body));
+    assert_true(pb_encode(&stream, Hedera_TransactionBody_fields, &transaction));
+    body_length = stream.bytes_written;
+}
+
+// Send one request to a handler, as main.c does: the exception it throws,
+// or 0 if it returned
+static unsigned int signing_request(handler_fn_t *handler, uint8_t p1,
+                                    uint8_t p2, const uint8_t *data,
+                                    uint16_t len) {
+    volatile unsigned int flags = 0;
+    volatile unsigned int tx = 0;
+
+    if (len != 0) {
+        memcpy(G_io_apdu_buffer + OFFSET_CDATA, data, len);
+    }
+    signing_mock_exception = 0;
+    if (setjmp(signing_mock_throw) != 0) {
+        return signing_mock_exception;
+    }
+    handler(p1, p2, G_io_apdu_buffer + OFFSET_CDATA, len, &flags, &tx);
+    return 0;
+}
+
+// Approval of the review on screen, as review_choice of ui_sign_transaction.c
+static void approve_review(void) {
+    if (st_ctx.reviewed_body == ReviewedQueue) {
+        queue_answer(true);
+        return;
+    }
+    if (sign_reviewed_transaction()) {
+        io_exchange_with_code(EXCEPTION_OK, st_ctx.signature_length);
+        batch_approved();
+    } else {
+        io_exchange_with_code(EXCEPTION_INTERNAL, 0);
+    }
+}
+
+static void expect_signature(void) {
+    assert_int_equal(signing_mock_reply_code, EXCEPTION_OK);
+    assert_int_equal(signing_mock_reply_length, ED25519_SIGNATURE_SIZE);
+    assert_int_equal(G_io_apdu_buffer[0], SIGNING_MOCK_SIGNATURE_BYTE);
+}
+
+// index (4, LE) | node count (1) | body length (2, LE) | nodes | body
+static unsigned int start_batch(void) {
+    uint8_t data[BATCH_HEADER_SIZE + TEST_NODE_COUNT * BATCH_NODE_SIZE +
+                 MAX_TX_SIZE] = {0};
+    uint8_t *node = data + BATCH_HEADER_SIZE;
+
+    data[0] = TEST_KEY_INDEX;
+    data[INDEX_SIZE] = TEST_NODE_COUNT;
+    data[INDEX_SIZE + 1] = (uint8_t)body_length;
+    data[INDEX_SIZE + 2] = (uint8_t)(body_length >> 8);
+    for (uint8_t i = 0; i < TEST_NODE_COUNT; i++) {
+        // 0.0.3, 0.0.4: account of the node, 8 bytes LE after shard and realm
+        node[i * BATCH_NODE_SIZE + 16] = 3 + i;
+    }
+    memcpy(node + TEST_NODE_COUNT * BATCH_NODE_SIZE, body, body_length);
+
+    return signing_request(
+        handle_sign_transaction_batch, P1_BATCH_START, 0, data,
+        (uint16_t)(BATCH_HEADER_SIZE + TEST_NODE_COUNT * BATCH_NODE_SIZE +
+                   body_length));
+}
+
+static unsigned int next_batch_signature(void) {
+    return signing_request(handle_sign_transaction_batch, P1_BATCH_NEXT, 0,
+                           NULL, 0);
+}
+
+// index (4, LE) | body, answered with its position
+static unsigned int add_to_queue(void) {
+    uint8_t data[INDEX_SIZE + MAX_TX_SIZE] = {0};
+
+    data[0] = TEST_KEY_INDEX;
+    memcpy(data + INDEX_SIZE, body, body_length);
+
+    return signing_request(handle_sign_transaction_queue, P1_QUEUE_ADD, 0,
+                           data, (uint16_t)(INDEX_SIZE + body_length));
+}
+
+// Add TEST_QUEUE_LENGTH bodies and start their reviews
+static void fill_queue(void) {
+    for (uint8_t i = 0; i < TEST_QUEUE_LENGTH; i++) {
+        assert_int_equal(add_to_queue(), 0);
+        assert_int_equal(G_io_apdu_buffer[0], i);
+    }
+    assert_int_equal(signing_request(handle_sign_transaction_queue,
+                                     P1_QUEUE_REVIEW, 0, NULL, 0),
+                     0);
+}
+
+static void expect_answers(uint8_t first, uint8_t second) {
+    assert_int_equal(signing_mock_reply_code, EXCEPTION_OK);
+    assert_int_equal(signing_mock_reply_length, TEST_QUEUE_LENGTH);
+    assert_int_equal(G_io_apdu_buffer[0], first);
+    assert_int_equal(G_io_apdu_buffer[1], second);
+}
+
+static unsigned int queue_signature(uint8_t position) {
+    return signing_request(handle_sign_transaction_queue, P1_QUEUE_SIGNATURE,
+                           0, &position, 1);
+}
+
+static void reset_requests(void) {
+    drop_pending_requests();
+    signing_mock_reviews = 0;
+    signing_mock_cache_resets = 0;
+    signing_mock_reply_code = 0;
+    signing_mock_reply_length = 0;
+    encode_transfer_body();
+}
+
+static void test_batch_signed_for_every_node(void **state) {
+    (void)state;
+    reset_requests();
+
+    assert_int_equal(start_batch(), 0);
+    assert_int_equal(signing_mock_reviews, 1);
+
+    approve_review();
+    expect_signature();
+
+    assert_int_equal(next_batch_signature(), 0);
+    expect_signature();
+
+    // Every node has its signature
+    assert_int_equal(next_batch_signature(), EXCEPTION_MALFORMED_APDU);
+}
+
+static void test_batch_dropped_on_lock(void **state) {
+    (void)state;
+    reset_requests();
+
+    assert_int_equal(start_batch(), 0);
+    approve_review();
+    expect_signature();
+
+    drop_session_on_lock();
+    assert_int_equal(signing_mock_cache_resets, 1);
+
+    // The remaining node needs a new review
+    assert_int_equal(next_batch_signature(), EXCEPTION_MALFORMED_APDU);
+    assert_int_equal(batch_ctx.state, BATCH_NONE);
+}
+
+static void test_batch_review_dropped_on_lock(void **state) {
+    (void)state;
+    reset_requests();
+
+    assert_int_equal(start_batch(), 0);
+
+    drop_session_on_lock();
+
+    // Approved after the unlock, nothing left to sign
+    approve_review();
+    assert_int_equal(signing_mock_reply_code, EXCEPTION_INTERNAL);
+    assert_int_equal(next_batch_signature(), EXCEPTION_MALFORMED_APDU);
+}
+
+static void test_queue_signed_once(void **state) {
+    (void)state;
+    reset_requests();
+
+    fill_queue();
+    approve_review();
+    approve_review();
+    expect_answers(1, 1);
+    assert_int_equal(signing_mock_reviews, TEST_QUEUE_LENGTH);
+
+    assert_int_equal(queue_signature(0), 0);
+    expect_signature();
+    assert_int_equal(queue_signature(0), EXCEPTION_MALFORMED_APDU);
+
+    // The last approved body has its signature
+    assert_int_equal(queue_signature(1), 0);
+    expect_signature();
+    assert_int_equal(queue_ctx.state, QUEUE_NONE);
+    assert_int_equal(queue_signature(1), EXCEPTION_MALFORMED_APDU);
+}
+
+static void test_queue_dropped_after_last_approved(void **state) {
+    (void)state;
+    reset_requests();
+
+    fill_queue();
+    queue_answer(false);
+    approve_review();
+    expect_answers(0, 1);
+
+    assert_int_equal(queue_signature(0), EXCEPTION_USER_REJECTED);
+    assert_int_equal(queue_signature(1), 0);
+    expect_signature();
+
+    // Only the rejected body was left
+    assert_int_equal(queue_ctx.state, QUEUE_NONE);
+    assert_int_equal(queue_signature(0), EXCEPTION_MALFORMED_APDU);
+}
+
+static void test_queue_dropped_on_lock(void **state) {
+    (void)state;
+    reset_requests();
+
+    fill_queue();
+    approve_review();
+    approve_review();
+    expect_answers(1, 1);
+    assert_int_equal(queue_signature(0), 0);
+
+    drop_session_on_lock();
+
+    // The remaining body needs a new review
+    assert_int_equal(queue_signature(1), EXCEPTION_MALFORMED_APDU);
+    assert_int_equal(queue_ctx.state, QUEUE_NONE);
+}
+
+static void test_queue_review_dropped_on_lock(void **state) {
+    (void)state;
+    reset_requests();
+
+    fill_queue();
+    approve_review();
+
+    drop_session_on_lock();
+
+    // Approved after the unlock, the host gets an error instead of the
+    // answers
+    approve_review();
+    assert_int_equal(signing_mock_reply_code, EXCEPTION_INTERNAL);
+    assert_int_equal(queue_signature(0), EXCEPTION_MALFORMED_APDU);
+}
+
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_batch_signed_for_every_node),
+        cmocka_unit_test(test_batch_dropped_on_lock),
+        cmocka_unit_test(test_batch_review_dropped_on_lock),
+        cmocka_unit_test(test_queue_signed_once),
+        cmocka_unit_test(test_queue_dropped_after_last_approved),
+        cmocka_unit_test(test_queue_dropped_on_lock),
+        cmocka_unit_test(test_queue_review_dropped_on_lock),
+    };
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,127 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <string.h>
+#include <cmocka.h>
+
+#define PB_SYSTEM_HEADER "nanopb_system.h"
+#include <pb_common.h>
+
+#include "transaction_body.pb.h"
+
+static const pb_msgdesc_t *const descriptors[] = {
+    &Hedera_ShardID_msg,
+    &Hedera_RealmID_msg,
+    &Hedera_AccountID_msg,
+    &Hedera_FileID_msg,
+    &Hedera_ContractID_msg,
+    &Hedera_TransactionID_msg,
+    &Hedera_AccountAmount_msg,
+    &Hedera_TransferList_msg,
+    &Hedera_NftTransfer_msg,
+    &Hedera_TokenTransferList_msg,
+    &Hedera_Fraction_msg,
+    &Hedera_TokenID_msg,
+    &Hedera_Key_msg,
+    &Hedera_ThresholdKey_msg,
+    &Hedera_KeyList_msg,
+    &Hedera_TokenBalance_msg,
+    &Hedera_TokenBalances_msg,
+    &Hedera_TokenAssociation_msg,
+    &Hedera_StakingInfo_msg,
+    &Hedera_ContractCallTransactionBody_msg,
+    &Hedera_CryptoCreateTransactionBody_msg,
+    &Hedera_CryptoTransferTransactionBody_msg,
+    &Hedera_CryptoUpdateTransactionBody_msg,
+    &Hedera_Duration_msg,
+    &Hedera_Timestamp_msg,
+    &Hedera_TimestampSeconds_msg,
+    &Hedera_TokenAssociateTransactionBody_msg,
+    &Hedera_TokenBurnTransactionBody_msg,
+    &Hedera_TokenDissociateTransactionBody_msg,
+    &Hedera_TokenMintTransactionBody_msg,
+    &Hedera_TransactionBody_msg,
+    &Hedera_DoubleValue_msg,
+    &Hedera_FloatValue_msg,
+    &Hedera_Int64Value_msg,
+    &Hedera_UInt64Value_msg,
+    &Hedera_Int32Value_msg,
+    &Hedera_UInt32Value_msg,
+    &Hedera_BoolValue_msg,
+    &Hedera_StringValue_msg,
+};
+
+// Large enough for any of the messages above
+static uint8_t message[sizeof(Hedera_TransactionBody)];
+
+// Iterator on the given field, found by stepping from the first one
+static void iter_at(pb_field_iter_t *iter, const pb_msgdesc_t *descriptor,
+                    pb_size_t index) {
+    assert_true(pb_field_iter_begin(iter, descriptor, message));
+    for (pb_size_t i = 0; i < index; i++) {
+        pb_field_iter_next(iter);
+    }
+}
+
+// Every tag looked up from every field gives the same result and the same
+// iterator as the search over the descriptor
+static void test_tag_index_matches_search(void **state) {
+    (void)state;
+
+    for (size_t i = 0; i < sizeof(descriptors) / sizeof(descriptors[0]); i++) {
+        const pb_msgdesc_t *indexed = descriptors[i];
+        pb_msgdesc_t unindexed = *indexed;
+        unindexed.tag_index = NULL;
+
+        assert_non_null(indexed->tag_index);
+
+        for (pb_size_t start = 0; start < indexed->field_count; start++) {
+            for (uint32_t tag = 0; tag <= indexed->largest_tag + 1u; tag++) {
+                pb_field_iter_t expected;
+                pb_field_iter_t actual;
+
+                iter_at(&expected, &unindexed, start);
+                iter_at(&actual, indexed, start);
+
+                assert_int_equal(pb_field_iter_find(&actual, tag),
+                                 pb_field_iter_find(&expected, tag));
+
+                // Only the descriptor differs
+                actual.descriptor = &unindexed;
+                assert_memory_equal(&actual, &expected, sizeof(expected));
+            }
+        }
+    }
+}
+
+static void test_found_field(void **state) {
+    (void)state;
+    Hedera_TransactionBody body;
+    pb_field_iter_t iter;
+
+    assert_true(pb_field_iter_begin(&iter, Hedera_TransactionBody_fields, &body));
+    assert_true(pb_field_iter_find(&iter, Hedera_TransactionBody_tokenBurn_tag));
+    assert_int_equal(iter.tag, Hedera_TransactionBody_tokenBurn_tag);
+    assert_ptr_equal(iter.pData, &body.data.tokenBurn);
+    assert_ptr_equal(iter.pSize, &body.which_data);
+    assert_ptr_equal(iter.submsg_desc, Hedera_TokenBurnTransactionBody_fields);
+
+    // Back to a lower tag
+    assert_true(pb_field_iter_find(&iter, Hedera_TransactionBody_memo_tag));
+    assert_ptr_equal(iter.pData, body.memo);
+
+    // Between fields and past the largest tag
+    assert_false(pb_field_iter_find(&iter, 20));
+    assert_false(pb_field_iter_find(&iter, 42));
+    assert_ptr_equal(iter.pData, body.memo);
+}
+
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_tag_index_matches_search),
+        cmocka_unit_test(test_found_field),
+    };
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
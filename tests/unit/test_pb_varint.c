@@ -0,0 +1,190 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <string.h>
+#include <cmocka.h>
+
+#define PB_SYSTEM_HEADER "nanopb_system.h"
+#include <pb_decode.h>
+#include <pb_varint.h>
+
+#include "proto_varlen_parser.h"
+
+// Random encodings checked for each length of the remaining input
+#define RANDOM_ENCODINGS 20000
+
+// Longer than any varint, so that the fast path is taken at full length
+#define INPUT_SIZE 16
+
+static uint32_t rng_state;
+
+// xorshift32, so that a failure can be replayed
+static uint32_t rng_next(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return rng_state;
+}
+
+// Same reads as the buffer stream, but through a callback other than
+// buf_read, so that nanopb decodes one byte at a time
+static bool byte_read(pb_istream_t *stream, pb_byte_t *buf, size_t count) {
+    const pb_byte_t *source = (const pb_byte_t *)stream->state;
+    stream->state = (pb_byte_t *)stream->state + count;
+    if (buf != NULL) {
+        memcpy(buf, source, count);
+    }
+    return true;
+}
+
+static pb_istream_t byte_stream(const uint8_t *input, size_t length) {
+    pb_istream_t stream = pb_istream_from_buffer(input, length);
+    stream.callback = byte_read;
+    return stream;
+}
+
+static void check_streams(pb_istream_t *fast, pb_istream_t *slow,
+                          bool fast_status, bool slow_status) {
+    assert_int_equal(fast_status, slow_status);
+    assert_int_equal(fast->bytes_left, slow->bytes_left);
+    assert_ptr_equal(fast->state, slow->state);
+}
+
+// Every decoder gives the same result and leaves the stream at the same
+// place as the byte-by-byte path, for the first length bytes of input
+static void check_input(const uint8_t *input, size_t length) {
+    pb_istream_t fast;
+    pb_istream_t slow;
+    bool fast_status;
+    bool slow_status;
+
+    uint64_t fast_value = 0;
+    uint64_t slow_value = 0;
+    fast = pb_istream_from_buffer(input, length);
+    slow = byte_stream(input, length);
+    fast_status = pb_decode_varint(&fast, &fast_value);
+    slow_status = pb_decode_varint(&slow, &slow_value);
+    check_streams(&fast, &slow, fast_status, slow_status);
+    assert_true(fast_value == slow_value);
+
+    uint32_t fast_value32 = 0;
+    uint32_t slow_value32 = 0;
+    fast = pb_istream_from_buffer(input, length);
+    slow = byte_stream(input, length);
+    fast_status = pb_decode_varint32(&fast, &fast_value32);
+    slow_status = pb_decode_varint32(&slow, &slow_value32);
+    check_streams(&fast, &slow, fast_status, slow_status);
+    assert_int_equal(fast_value32, slow_value32);
+
+    fast = pb_istream_from_buffer(input, length);
+    slow = byte_stream(input, length);
+    fast_status = pb_skip_field(&fast, PB_WT_VARINT);
+    slow_status = pb_skip_field(&slow, PB_WT_VARINT);
+    check_streams(&fast, &slow, fast_status, slow_status);
+
+    // The second-stage parser reads tags the same way
+    const uint8_t *data = input;
+    protobuf_field_t field;
+    slow = byte_stream(input, length);
+    slow_status = pb_decode_varint(&slow, &slow_value);
+    assert_int_equal(parse_field_tag(&data, input + length, &field),
+                     slow_status);
+    if (slow_status) {
+        assert_ptr_equal(data, slow.state);
+        assert_int_equal(field.field_number, (uint32_t)(slow_value >> 3));
+        assert_int_equal(field.wire_type, (wire_type_t)(slow_value & 0x07));
+    }
+}
+
+static void check_all_lengths(const uint8_t *input) {
+    for (size_t length = 0; length <= INPUT_SIZE; length++) {
+        check_input(input, length);
+    }
+}
+
+static size_t encode(uint64_t value, uint8_t *output) {
+    size_t size = 0;
+    while (value >= 0x80) {
+        output[size++] = (uint8_t)(value | 0x80);
+        value >>= 7;
+    }
+    output[size++] = (uint8_t)value;
+    return size;
+}
+
+static void test_values(void **state) {
+    (void)state;
+    uint8_t input[INPUT_SIZE];
+
+    for (unsigned int bit = 0; bit < 64; bit++) {
+        const uint64_t power = (uint64_t)1 << bit;
+        const uint64_t values[] = {power - 1, power, power + 1, ~power,
+                                   (uint64_t)-(int64_t)power};
+
+        for (size_t i = 0; i < sizeof(values) / sizeof(values[0]); i++) {
+            memset(input, 0x00, sizeof(input));
+            size_t size = encode(values[i], input);
+
+            uint64_t value = 0;
+            assert_int_equal(pb_varint_decode_unchecked(input, &value), size);
+            assert_true(value == values[i]);
+
+            check_all_lengths(input);
+        }
+    }
+}
+
+// Padded encodings of 0 and 1, up to the 11 bytes that overflow
+static void test_padding(void **state) {
+    (void)state;
+    uint8_t input[INPUT_SIZE];
+
+    for (size_t size = 1; size <= PB_VARINT_MAX_SIZE + 1; size++) {
+        for (uint8_t first = 0; first <= 1; first++) {
+            memset(input, 0x80, sizeof(input));
+            input[0] = (uint8_t)(first | (size > 1 ? 0x80 : 0x00));
+            input[size - 1] &= 0x7F;
+            check_all_lengths(input);
+        }
+    }
+
+    // Sign-extended negative int32, and its overflowing variants
+    const uint8_t negative[] = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+                                0xFF, 0xFF, 0xFF, 0xFF, 0x01};
+    memset(input, 0x00, sizeof(input));
+    memcpy(input, negative, sizeof(negative));
+    check_all_lengths(input);
+    input[9] = 0x03;
+    check_all_lengths(input);
+    input[9] = 0xFF;
+    check_all_lengths(input);
+    input[4] = 0x7F;
+    check_all_lengths(input);
+}
+
+static void test_random(void **state) {
+    (void)state;
+    uint8_t input[INPUT_SIZE];
+
+    rng_state = 0x2545F491;
+    for (int n = 0; n < RANDOM_ENCODINGS; n++) {
+        // Mostly continuation bytes, ended at a random place or not at all
+        const size_t size = rng_next() % (INPUT_SIZE + 1);
+        for (size_t i = 0; i < sizeof(input); i++) {
+            uint8_t byte = (uint8_t)rng_next();
+            input[i] = i < size ? (byte | 0x80) : (byte & 0x7F);
+        }
+        check_all_lengths(input);
+    }
+}
+
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_values),
+        cmocka_unit_test(test_padding),
+        cmocka_unit_test(test_random),
+    };
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -98,6 +98,22 @@ static void test_handle_contract_call_body_throws_on_invalid(void **state) {
     g_last_throw = 0;
     handle_contract_call_body();
     assert_int_equal(g_last_throw, EXCEPTION_MALFORMED_APDU);
+    assert_int_equal(st_ctx.refusal_reason, REFUSAL_CONTRACT_CALL);
+}
+
+static void test_handle_contract_call_body_unsupported_selector(void **state) {
+    (void)state;
+    reset_ctx();
+    // approve(address,uint256) is not supported
+    st_ctx.transaction.data.contractCall.functionParameters.size = 4 + 32 + 32;
+    st_ctx.transaction.data.contractCall.functionParameters.bytes[0] = 0x09;
+    st_ctx.transaction.data.contractCall.functionParameters.bytes[1] = 0x5E;
+    st_ctx.transaction.data.contractCall.functionParameters.bytes[2] = 0xA7;
+    st_ctx.transaction.data.contractCall.functionParameters.bytes[3] = 0xB3;
+    g_last_throw = 0;
+    handle_contract_call_body();
+    assert_int_equal(g_last_throw, EXCEPTION_MALFORMED_APDU);
+    assert_int_equal(st_ctx.refusal_reason, REFUSAL_UNSUPPORTED_SELECTOR);
 }
 
 static void test_contract_call_just_over_limit(void **state) {
@@ -128,6 +144,7 @@ int main(void) {
         cmocka_unit_test(test_contract_call_invalid_evm_address_size),
         cmocka_unit_test(test_contract_call_too_long_calldata),
         cmocka_unit_test(test_handle_contract_call_body_throws_on_invalid),
+        cmocka_unit_test(test_handle_contract_call_body_unsupported_selector),
         cmocka_unit_test(test_contract_call_just_over_limit),
     };
     return cmocka_run_group_tests(tests, NULL, NULL);
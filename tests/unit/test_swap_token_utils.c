@@ -0,0 +1,72 @@
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+
+#include "swap/swap_token_utils.h"
+
+static void test_parse_account_id_valid(void **state) {
+    (void)state;
+    swap_account_id_t account_id = {0};
+    assert_true(swap_parse_account_id("100.101.110", &account_id));
+    assert_int_equal(account_id.shard, 100);
+    assert_int_equal(account_id.realm, 101);
+    assert_int_equal(account_id.num, 110);
+
+    assert_true(swap_parse_account_id("0.0.9223372036854775807", &account_id));
+    assert_int_equal(account_id.shard, 0);
+    assert_int_equal(account_id.realm, 0);
+    assert_int_equal(account_id.num, 9223372036854775807ULL);
+}
+
+static void test_parse_account_id_leading_zeros(void **state) {
+    (void)state;
+    swap_account_id_t account_id = {0};
+    // Same account as 0.0.98
+    assert_true(swap_parse_account_id("00.0.098", &account_id));
+    assert_int_equal(account_id.shard, 0);
+    assert_int_equal(account_id.realm, 0);
+    assert_int_equal(account_id.num, 98);
+}
+
+static void test_parse_account_id_invalid(void **state) {
+    (void)state;
+    static const char *const invalid[] = {
+        "",
+        "0",
+        "0.0",
+        "0.0.",
+        ".0.98",
+        "0..98",
+        "0.0.98.",
+        "0.0.98 ",
+        " 0.0.98",
+        "0.0.-98",
+        "0.0.+98",
+        "0.0.98-abcde",
+        "0x3333333333333333333333333333333333333333",
+        "0.0.9223372036854775808",
+        "0.0.99999999999999999999",
+    };
+    for (size_t i = 0; i < sizeof(invalid) / sizeof(invalid[0]); i++) {
+        swap_account_id_t account_id = {1, 2, 3};
+        assert_false(swap_parse_account_id(invalid[i], &account_id));
+        // Untouched on failure
+        assert_int_equal(account_id.shard, 1);
+        assert_int_equal(account_id.realm, 2);
+        assert_int_equal(account_id.num, 3);
+    }
+
+    swap_account_id_t account_id;
+    assert_false(swap_parse_account_id(NULL, &account_id));
+}
+
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_parse_account_id_valid),
+        cmocka_unit_test(test_parse_account_id_leading_zeros),
+        cmocka_unit_test(test_parse_account_id_invalid),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
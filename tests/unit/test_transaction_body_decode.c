@@ -0,0 +1,509 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <string.h>
+#include <cmocka.h>
+
+#define PB_SYSTEM_HEADER "nanopb_system.h"
+#include <pb_decode.h>
+#include <pb_encode.h>
+
+#include "transaction_body.pb.h"
+#include "transaction_body_decode.h"
+
+// Mutated copies decoded for each seed body
+#define MUTATIONS_PER_SEED 20000
+
+// Bodies may grow past the decoder limits when mutated
+#define BODY_BUFFER_SIZE 1024
+
+typedef struct body_s {
+    uint8_t bytes[BODY_BUFFER_SIZE];
+    size_t length;
+} body_t;
+
+static Hedera_TransactionBody expected;
+static Hedera_TransactionBody actual;
+
+static uint32_t rng_state;
+
+// xorshift32, so that a failure can be replayed
+static uint32_t rng_next(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return rng_state;
+}
+
+static uint32_t rng_below(uint32_t bound) { return rng_next() % bound; }
+
+// What the callbacks saw during one decoding
+typedef struct capture_s {
+    uint32_t updates;
+    uint32_t memos;
+    char memo[8];
+} capture_t;
+
+static capture_t capture;
+
+// Same reads as the account memo callback of the app
+static bool capture_memo(pb_istream_t *stream, const pb_field_t *field,
+                         void **arg) {
+    (void)field;
+    capture_t *seen = *arg;
+    size_t length = stream->bytes_left;
+    if (length > sizeof(seen->memo) - 1) {
+        length = sizeof(seen->memo) - 1;
+    }
+
+    seen->memos++;
+    memset(seen->memo, 0, sizeof(seen->memo));
+    return pb_read(stream, (pb_byte_t *)seen->memo, length) &&
+           pb_read(stream, NULL, stream->bytes_left);
+}
+
+// Message callback of cryptoUpdateAccount, which sets the memo callback
+static bool capture_update(pb_istream_t *stream, const pb_field_t *field,
+                           void **arg) {
+    (void)stream;
+    capture_t *seen = *arg;
+    assert_int_equal(field->tag, Hedera_TransactionBody_cryptoUpdateAccount_tag);
+
+    Hedera_CryptoUpdateTransactionBody *update = field->pData;
+    update->memo.value.funcs.decode = capture_memo;
+    update->memo.value.arg = seen;
+    seen->updates++;
+    return true;
+}
+
+static void set_capture(Hedera_TransactionBody *transaction) {
+    transaction->cb_data.funcs.decode = capture_update;
+    transaction->cb_data.arg = &capture;
+}
+
+// Decode with both decoders into structures holding the same leftovers, and
+// expect the same status, position, structure and callbacks, even on failure
+static void assert_same_decoding(const uint8_t *buffer, size_t length,
+                                 uint8_t filler) {
+    memset(&expected, filler, sizeof(expected));
+    memset(&actual, filler, sizeof(actual));
+    set_capture(&expected);
+    set_capture(&actual);
+
+    pb_istream_t expected_stream = pb_istream_from_buffer(buffer, length);
+    pb_istream_t actual_stream = pb_istream_from_buffer(buffer, length);
+
+    memset(&capture, 0, sizeof(capture));
+    bool expected_status =
+        pb_decode(&expected_stream, Hedera_TransactionBody_fields, &expected);
+    capture_t expected_capture = capture;
+
+    memset(&capture, 0, sizeof(capture));
+    bool actual_status = Hedera_TransactionBody_decode(&actual_stream, &actual);
+
+    assert_int_equal(actual_status, expected_status);
+    assert_int_equal(actual_stream.bytes_left, expected_stream.bytes_left);
+    assert_memory_equal(&actual, &expected, sizeof(expected));
+    assert_memory_equal(&capture, &expected_capture, sizeof(capture));
+}
+
+static void encode_body(const Hedera_TransactionBody *transaction,
+                        body_t *body) {
+    pb_ostream_t stream = pb_ostream_from_buffer(body->bytes,
+                                                 sizeof(body->bytes));
+    assert_true(pb_encode(&stream, Hedera_TransactionBody_fields, transaction));
+    body->length = stream.bytes_written;
+}
+
+static void set_account(Hedera_AccountID *account, int64_t num) {
+    account->shardNum = 0;
+    account->realmNum = 0;
+    account->which_account = Hedera_AccountID_accountNum_tag;
+    account->account.accountNum = num;
+}
+
+static void set_header(Hedera_TransactionBody *transaction) {
+    transaction->has_transactionID = true;
+    transaction->transactionID.has_transactionValidStart = true;
+    transaction->transactionID.transactionValidStart.seconds = 1700000000;
+    transaction->transactionID.transactionValidStart.nanos = -5;
+    transaction->transactionID.has_accountID = true;
+    set_account(&transaction->transactionID.accountID, 1234);
+    transaction->transactionID.nonce = 7;
+    transaction->has_nodeAccountID = true;
+    set_account(&transaction->nodeAccountID, 3);
+    transaction->transactionFee = 100000;
+    transaction->has_transactionValidDuration = true;
+    transaction->transactionValidDuration.seconds = 120;
+    transaction->generateRecord = true;
+    strcpy(transaction->memo, "memo");
+}
+
+static void seed_crypto_transfer(body_t *body) {
+    Hedera_TransactionBody transaction = Hedera_TransactionBody_init_zero;
+    set_header(&transaction);
+
+    transaction.which_data = Hedera_TransactionBody_cryptoTransfer_tag;
+    Hedera_CryptoTransferTransactionBody *transfer =
+        &transaction.data.cryptoTransfer;
+    transfer->has_transfers = true;
+    transfer->transfers.accountAmounts_count = 2;
+    transfer->transfers.accountAmounts[0].has_accountID = true;
+    set_account(&transfer->transfers.accountAmounts[0].accountID, 1234);
+    transfer->transfers.accountAmounts[0].amount = -100000000;
+    transfer->transfers.accountAmounts[1].has_accountID = true;
+    transfer->transfers.accountAmounts[1].accountID.which_account =
+        Hedera_AccountID_alias_tag;
+    transfer->transfers.accountAmounts[1].accountID.account.alias.size = 3;
+    memcpy(transfer->transfers.accountAmounts[1].accountID.account.alias.bytes,
+           "abc", 3);
+    transfer->transfers.accountAmounts[1].amount = 100000000;
+    transfer->transfers.accountAmounts[1].is_approval = true;
+
+    transfer->tokenTransfers_count = 1;
+    Hedera_TokenTransferList *tokens = &transfer->tokenTransfers[0];
+    tokens->has_token = true;
+    tokens->token.tokenNum = 42;
+    tokens->transfers_count = 1;
+    tokens->transfers[0].has_accountID = true;
+    set_account(&tokens->transfers[0].accountID, 5);
+    tokens->transfers[0].amount = 10;
+    tokens->nftTransfers_count = 1;
+    tokens->nftTransfers[0].has_senderAccountID = true;
+    set_account(&tokens->nftTransfers[0].senderAccountID, 5);
+    tokens->nftTransfers[0].has_receiverAccountID = true;
+    set_account(&tokens->nftTransfers[0].receiverAccountID, 6);
+    tokens->nftTransfers[0].serialNumber = 9;
+    tokens->has_expected_decimals = true;
+    tokens->expected_decimals.value = 8;
+
+    encode_body(&transaction, body);
+}
+
+static void seed_crypto_create(body_t *body) {
+    Hedera_TransactionBody transaction = Hedera_TransactionBody_init_zero;
+    set_header(&transaction);
+
+    transaction.which_data = Hedera_TransactionBody_cryptoCreateAccount_tag;
+    Hedera_CryptoCreateTransactionBody *create =
+        &transaction.data.cryptoCreateAccount;
+    create->has_key = true;
+    create->key.which_key = Hedera_Key_ed25519_tag;
+    create->key.key.ed25519.size = 32;
+    memset(create->key.key.ed25519.bytes, 0x11, 32);
+    create->initialBalance = 500;
+    create->has_proxyAccountID = true;
+    set_account(&create->proxyAccountID, 8);
+    create->receiverSigRequired = true;
+    create->has_autoRenewPeriod = true;
+    create->autoRenewPeriod.seconds = 7776000;
+    create->has_shardID = true;
+    create->has_realmID = true;
+    create->realmID.realmNum = 1;
+    create->has_newRealmAdminKey = true;
+    create->newRealmAdminKey.which_key = Hedera_Key_contractID_tag;
+    create->newRealmAdminKey.key.contractID.which_contract =
+        Hedera_ContractID_contractNum_tag;
+    create->newRealmAdminKey.key.contractID.contract.contractNum = 77;
+    strcpy(create->memo, "new account");
+    create->max_automatic_token_associations = -1;
+    create->which_staked_id = Hedera_CryptoCreateTransactionBody_staked_node_id_tag;
+    create->staked_id.staked_node_id = 4;
+    create->decline_reward = true;
+
+    encode_body(&transaction, body);
+}
+
+static void seed_crypto_update(body_t *body) {
+    Hedera_TransactionBody transaction = Hedera_TransactionBody_init_zero;
+    set_header(&transaction);
+
+    transaction.which_data = Hedera_TransactionBody_cryptoUpdateAccount_tag;
+    Hedera_CryptoUpdateTransactionBody *update =
+        &transaction.data.cryptoUpdateAccount;
+    update->has_accountIDToUpdate = true;
+    set_account(&update->accountIDToUpdate, 1234);
+    update->has_key = true;
+    update->key.which_key = Hedera_Key_ECDSA_secp256k1_tag;
+    update->key.key.ECDSA_secp256k1.size = 32;
+    memset(update->key.key.ECDSA_secp256k1.bytes, 0x02, 32);
+    update->proxyFraction = 3;
+    update->which_sendRecordThresholdField =
+        Hedera_CryptoUpdateTransactionBody_sendRecordThresholdWrapper_tag;
+    update->sendRecordThresholdField.sendRecordThresholdWrapper.value = 12;
+    update->which_receiverSigRequiredField =
+        Hedera_CryptoUpdateTransactionBody_receiverSigRequired_tag;
+    update->receiverSigRequiredField.receiverSigRequired = true;
+    update->has_expirationTime = true;
+    update->expirationTime.seconds = 1800000000;
+    update->has_max_automatic_token_associations = true;
+    update->max_automatic_token_associations.value = 10;
+    update->which_staked_id =
+        Hedera_CryptoUpdateTransactionBody_staked_account_id_tag;
+    set_account(&update->staked_id.staked_account_id, 800);
+    update->has_decline_reward = true;
+    update->decline_reward.value = true;
+
+    encode_body(&transaction, body);
+
+    // The memo is a callback field, which pb_encode leaves out: appended as
+    // a second cryptoUpdateAccount, merged into the first one
+    static const uint8_t memo[] = {0x7A, 0x06, 0x72, 0x04,
+                                   0x0A, 0x02, 'h',  'i'};
+    memcpy(body->bytes + body->length, memo, sizeof(memo));
+    body->length += sizeof(memo);
+}
+
+static void seed_token_mint(body_t *body) {
+    Hedera_TransactionBody transaction = Hedera_TransactionBody_init_zero;
+    set_header(&transaction);
+
+    transaction.which_data = Hedera_TransactionBody_tokenMint_tag;
+    Hedera_TokenMintTransactionBody *mint = &transaction.data.tokenMint;
+    mint->has_token = true;
+    mint->token.tokenNum = 99;
+    mint->amount = 1000;
+    mint->metadata_count = 1;
+    mint->metadata[0].size = 4;
+    memcpy(mint->metadata[0].bytes, "ipfs", 4);
+
+    encode_body(&transaction, body);
+}
+
+static void seed_token_burn(body_t *body) {
+    Hedera_TransactionBody transaction = Hedera_TransactionBody_init_zero;
+    set_header(&transaction);
+
+    transaction.which_data = Hedera_TransactionBody_tokenBurn_tag;
+    Hedera_TokenBurnTransactionBody *burn = &transaction.data.tokenBurn;
+    burn->has_token = true;
+    burn->token.tokenNum = 99;
+    burn->amount = 5;
+    burn->serialNumbers_count = 1;
+    burn->serialNumbers[0] = 300;
+
+    encode_body(&transaction, body);
+}
+
+static void seed_token_associate(body_t *body) {
+    Hedera_TransactionBody transaction = Hedera_TransactionBody_init_zero;
+    set_header(&transaction);
+
+    transaction.which_data = Hedera_TransactionBody_tokenAssociate_tag;
+    Hedera_TokenAssociateTransactionBody *associate =
+        &transaction.data.tokenAssociate;
+    associate->has_account = true;
+    set_account(&associate->account, 1234);
+    associate->tokens_count = 1;
+    associate->tokens[0].realmNum = 2;
+    associate->tokens[0].tokenNum = 3;
+
+    encode_body(&transaction, body);
+}
+
+static void seed_token_dissociate(body_t *body) {
+    Hedera_TransactionBody transaction = Hedera_TransactionBody_init_zero;
+    set_header(&transaction);
+
+    transaction.which_data = Hedera_TransactionBody_tokenDissociate_tag;
+    Hedera_TokenDissociateTransactionBody *dissociate =
+        &transaction.data.tokenDissociate;
+    dissociate->has_account = true;
+    set_account(&dissociate->account, 1234);
+    dissociate->tokens_count = 1;
+    dissociate->tokens[0].tokenNum = 1;
+
+    encode_body(&transaction, body);
+}
+
+static void seed_contract_call(body_t *body) {
+    Hedera_TransactionBody transaction = Hedera_TransactionBody_init_zero;
+    set_header(&transaction);
+
+    transaction.which_data = Hedera_TransactionBody_contractCall_tag;
+    Hedera_ContractCallTransactionBody *call = &transaction.data.contractCall;
+    call->has_contractID = true;
+    call->contractID.which_contract = Hedera_ContractID_evm_address_tag;
+    call->contractID.contract.evm_address.size = 20;
+    memset(call->contractID.contract.evm_address.bytes, 0x44, 20);
+    call->gas = 100000;
+    call->amount = 1;
+    call->functionParameters.size = 4;
+    memcpy(call->functionParameters.bytes, "\xa9\x05\x9c\xbb", 4);
+
+    encode_body(&transaction, body);
+}
+
+static void (*const seeds[])(body_t *) = {
+    seed_crypto_transfer, seed_crypto_create,   seed_crypto_update,
+    seed_token_mint,      seed_token_burn,      seed_token_associate,
+    seed_token_dissociate, seed_contract_call,
+};
+
+static void mutate(body_t *body) {
+    uint32_t operations = 1 + rng_below(4);
+
+    for (uint32_t i = 0; i < operations; i++) {
+        size_t position = body->length ? rng_below(body->length) : 0;
+
+        switch (rng_below(6)) {
+            case 0:  // Bit flip
+                if (body->length) {
+                    body->bytes[position] ^= 1 << rng_below(8);
+                }
+                break;
+            case 1:  // Random byte
+                if (body->length) {
+                    body->bytes[position] = rng_next();
+                }
+                break;
+            case 2:  // Truncation
+                body->length = position;
+                break;
+            case 3:  // Insertion
+                if (body->length < sizeof(body->bytes)) {
+                    memmove(body->bytes + position + 1, body->bytes + position,
+                            body->length - position);
+                    body->bytes[position] = rng_next();
+                    body->length++;
+                }
+                break;
+            case 4:  // Deletion
+                if (body->length) {
+                    memmove(body->bytes + position, body->bytes + position + 1,
+                            body->length - position - 1);
+                    body->length--;
+                }
+                break;
+            default: {  // Repeated range, to overflow arrays
+                size_t length = rng_below(body->length - position + 1);
+                if (body->length + length <= sizeof(body->bytes)) {
+                    memcpy(body->bytes + body->length, body->bytes + position,
+                           length);
+                    body->length += length;
+                }
+                break;
+            }
+        }
+    }
+}
+
+static void test_seeds(void **state) {
+    (void)state;
+    body_t body;
+
+    for (size_t i = 0; i < sizeof(seeds) / sizeof(seeds[0]); i++) {
+        seeds[i](&body);
+        assert_same_decoding(body.bytes, body.length, 0x00);
+        pb_istream_t stream = pb_istream_from_buffer(body.bytes, body.length);
+        assert_true(Hedera_TransactionBody_decode(&stream, &actual));
+    }
+}
+
+static void test_hand_written(void **state) {
+    (void)state;
+
+    static const struct {
+        const char *name;
+        uint8_t bytes[24];
+        size_t length;
+    } cases[] = {
+        {"empty", {0}, 0},
+        {"zero tag", {0x00}, 1},
+        {"unknown varint field", {0xF8, 0x01, 0x05}, 3},
+        {"unknown group", {0x0B}, 1},
+        {"wrong wire type", {0x1D, 0, 0, 0, 0}, 5},
+        {"memo too long", {0x32, 0x64}, 2},
+        {"memo past the end", {0x32, 0x05, 'a'}, 3},
+        {"overlong varint", {0x18, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+                             0xFF, 0xFF, 0xFF, 0x01}, 12},
+        {"oneof switch", {0x3A, 0x02, 0x10, 0x01, 0x72, 0x02, 0x28, 0x01,
+                          0x3A, 0x00}, 10},
+        {"merged submessage", {0x0A, 0x02, 0x20, 0x01, 0x0A, 0x02, 0x18,
+                               0x01}, 8},
+        {"packed serial", {0xB2, 0x02, 0x03, 0x1A, 0x01, 0x01}, 6},
+        {"packed serials overflow", {0xB2, 0x02, 0x06, 0x1A, 0x04, 0x01, 0x02,
+                                     0x03, 0x04}, 9},
+        {"packed serials truncated", {0xB2, 0x02, 0x05, 0x1A, 0x03, 0x01,
+                                      0x80, 0x80}, 8},
+        {"nonce sign extension", {0x0A, 0x06, 0x20, 0xFF, 0xFF, 0xFF, 0xFF,
+                                  0x0F}, 8},
+        {"decimals too large", {0x72, 0x0A, 0x12, 0x08, 0x22, 0x06, 0x08,
+                                0xFF, 0xFF, 0xFF, 0xFF, 0x1F}, 12},
+        {"callback fixed32", {0x7A, 0x07, 0x72, 0x05, 0x0D, 0x01, 0x02, 0x03,
+                              0x04}, 9},
+        {"callback varint", {0x7A, 0x04, 0x72, 0x02, 0x08, 0x01}, 6},
+    };
+
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        assert_same_decoding(cases[i].bytes, cases[i].length, 0x00);
+        assert_same_decoding(cases[i].bytes, cases[i].length, 0xA5);
+    }
+}
+
+static void test_submessage_callback(void **state) {
+    (void)state;
+    body_t body;
+
+    seed_crypto_update(&body);
+    memset(&capture, 0, sizeof(capture));
+    memset(&actual, 0, sizeof(actual));
+    set_capture(&actual);
+    pb_istream_t stream = pb_istream_from_buffer(body.bytes, body.length);
+    assert_true(Hedera_TransactionBody_decode(&stream, &actual));
+
+    // Once per cryptoUpdateAccount of the seed
+    assert_int_equal(capture.updates, 2);
+    assert_int_equal(capture.memos, 1);
+    assert_string_equal(capture.memo, "hi");
+
+    // Cut to the size of the capture, and not set by other transactions
+    static const uint8_t long_memo[] = {0x7A, 0x0D, 0x72, 0x0B, 0x0A, 0x09,
+                                        '0',  '1',  '2',  '3',  '4',  '5',
+                                        '6',  '7',  '8'};
+    static const uint8_t token_mint[] = {0xAA, 0x02, 0x02, 0x10, 0x01};
+    const struct {
+        const uint8_t *bytes;
+        size_t length;
+        uint32_t updates;
+        const char *memo;
+    } cases[] = {
+        {long_memo, sizeof(long_memo), 1, "0123456"},
+        {token_mint, sizeof(token_mint), 0, ""},
+    };
+
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        assert_same_decoding(cases[i].bytes, cases[i].length, 0x00);
+        assert_int_equal(capture.updates, cases[i].updates);
+        assert_string_equal(capture.memo, cases[i].memo);
+    }
+}
+
+static void test_mutations(void **state) {
+    (void)state;
+    body_t seed;
+    body_t body;
+
+    for (size_t i = 0; i < sizeof(seeds) / sizeof(seeds[0]); i++) {
+        seeds[i](&seed);
+        rng_state = 0x9E3779B9 + i;
+
+        for (uint32_t j = 0; j < MUTATIONS_PER_SEED; j++) {
+            body = seed;
+            mutate(&body);
+            assert_same_decoding(body.bytes, body.length, j & 1 ? 0xA5 : 0x00);
+        }
+    }
+}
+
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_seeds),
+        cmocka_unit_test(test_hand_written),
+        cmocka_unit_test(test_submessage_callback),
+        cmocka_unit_test(test_mutations),
+    };
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}